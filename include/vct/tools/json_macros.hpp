@@ -53,7 +53,7 @@
 #define M_VCT_TOOLS_JSON_CONVERSION_FIELD( member_name ) \
     do {    \
         static_assert( std::is_constructible_v< ::vct::tools::Json, decltype(this->member_name) >, "VCT_TOOLS_JSON: " #member_name " use macros CONVERSION_FILED, Json must be constructible from it. " );  \
-        _json_value[ #member_name ] = ::vct::tools::Json{ _move_if_rvalue(this->member_name) };  \
+        _json_field( std::true_type{}, #member_name, this->member_name );  \
     }while(false);
     
 /**
@@ -86,7 +86,7 @@
 #define M_VCT_TOOLS_JSON_CONVERSION_MAP_FIELD( field_name, member_name ) \
     do {    \
         static_assert( std::is_constructible_v< ::vct::tools::Json, decltype(this->member_name) >, "VCT_TOOLS_JSON: " #member_name " use macros CONVERSION_FILED, Json must be constructible from it. " );  \
-        _json_value[ #field_name ] = ::vct::tools::Json{ _move_if_rvalue(this->member_name) };  \
+        _json_field( std::bool_constant< ::vct::tools::Json::Writer::is_raw_key( #field_name ) >{}, #field_name, this->member_name );  \
     }while(false);
 
 /**
@@ -100,8 +100,13 @@
  *          - && version: for rvalue references (moves values for optimization)
  *          - & version: for non-const lvalue references (returns references)
  *
+ *          And `void write_json(::vct::tools::Json::String& out) const`, which appends
+ *          the serialized object to `out` directly, without building a temporary Json.
+ *
  * @note The macro creates a JSON object and populates it using the provided field macros.
  *       Perfect forwarding ensures optimal performance based on value category.
+ *       `write_json` writes the field names as literals, members are written by `Json::Writer::value`,
+ *       so nested classes with `write_json` and ranges of them are also written directly.
  *
  * @example
  * @code
@@ -121,22 +126,39 @@
 #define M_VCT_TOOLS_JSON_CONVERSION_FUNCTION( class_name, ... )   \
     explicit operator ::vct::tools::Json() const & { \
         ::vct::tools::Json _json_value{ ::vct::tools::Json::Object{} }; \
-        auto _move_if_rvalue = [](const auto& val) -> const auto& { return val; }; \
+        auto _json_field = [&_json_value](auto, const char* _json_name, const auto& _json_member) { \
+            _json_value[ _json_name ] = ::vct::tools::Json{ _json_member }; \
+        }; \
         __VA_ARGS__ \
         return _json_value; \
     } \
     explicit operator ::vct::tools::Json() && { \
-    ::vct::tools::Json _json_value{ ::vct::tools::Json::Object{} }; \
-    auto _move_if_rvalue = [](auto& val) -> auto&& { return std::move(val); }; \
-    __VA_ARGS__ \
-    return _json_value; \
+        ::vct::tools::Json _json_value{ ::vct::tools::Json::Object{} }; \
+        auto _json_field = [&_json_value](auto, const char* _json_name, auto& _json_member) { \
+            _json_value[ _json_name ] = ::vct::tools::Json{ std::move(_json_member) }; \
+        }; \
+        __VA_ARGS__ \
+        return _json_value; \
     } \
     explicit operator ::vct::tools::Json() & { \
         ::vct::tools::Json _json_value{ ::vct::tools::Json::Object{} }; \
-        auto _move_if_rvalue = [](auto& val) -> auto& { return val; }; \
+        auto _json_field = [&_json_value](auto, const char* _json_name, auto& _json_member) { \
+            _json_value[ _json_name ] = ::vct::tools::Json{ _json_member }; \
+        }; \
         __VA_ARGS__ \
         return _json_value; \
     } \
+    void write_json( ::vct::tools::Json::String& _json_out ) const { \
+        ::vct::tools::Json::Writer _json_writer{ _json_out }; \
+        _json_writer.begin_object(); \
+        auto _json_field = [&_json_writer](auto _json_raw, const char* _json_name, const auto& _json_member) { \
+            if constexpr (decltype(_json_raw)::value) _json_writer.raw_key( _json_name ); \
+            else _json_writer.key( _json_name ); \
+            _json_writer.value( _json_member ); \
+        }; \
+        __VA_ARGS__ \
+        _json_writer.end_object(); \
+    } \
 
 /** @} */ // end of JSON_CONVERSION_MACROS
 
@@ -144,7 +166,8 @@
  * @defgroup JSON_CONSTRUCTOR_MACROS JSON Constructor Macros
  * @brief Macros for constructing C++ objects from JSON Values
  * @details These macros provide automatic deserialization from JSON to C++ class instances.
- *          They generate constructors that accept ::vct::tools::Json parameters.
+ *          They generate constructors that accept ::vct::tools::Json parameters,
+ *          and a `read_json` function that reads JSON text directly.
  * @{
  */
 
@@ -181,11 +204,8 @@
 #define M_VCT_TOOLS_JSON_CONSTRUCTOR_FIELD_OR(member_name, default_result, default_range_value) \
     do{ \
         static_assert( std::is_convertible_v<decltype(default_result), std::remove_cvref_t<decltype(member_name)>>, "VCT_TOOLS_JSON: " #member_name " use macros FIELD_OR, default_result must be convertible to member_type. "  );  \
-        this->member_name = ( \
-            (_json_value.is_obj() && _json_value.obj().contains( #member_name )) ? \
-            _json_value[ #member_name ].template move_or<std::remove_cvref_t<decltype(member_name)>,std::remove_cvref_t<decltype(default_range_value)>>( default_result, default_range_value ) : \
-            default_result \
-        );  \
+        _json_field( std::integral_constant<std::uint64_t, ::vct::tools::Json::Reader::key_hash( #member_name )>{}, #member_name, this->member_name, \
+            [&]{ return default_result; }, [&]{ return default_range_value; } );  \
     }while(false);
 
 /**
@@ -219,11 +239,8 @@
 #define M_VCT_TOOLS_JSON_CONSTRUCTOR_FIELD_DEFAULT(member_name) \
     do {    \
         static_assert( std::is_default_constructible_v<std::remove_cvref_t<decltype(member_name)>>, "VCT_TOOLS_JSON: " #member_name " use macros FIELD_DEFAULT, must is_default_constructible. "    );  \
-        this->member_name = ( \
-            (_json_value.is_obj() && _json_value.obj().contains( #member_name )) ? \
-            _json_value[ #member_name ].template move_or<std::remove_cvref_t<decltype(member_name)>>( std::remove_cvref_t<decltype(member_name)>{} ) : \
-            std::remove_cvref_t<decltype(member_name)>{} \
-        );  \
+        _json_field( std::integral_constant<std::uint64_t, ::vct::tools::Json::Reader::key_hash( #member_name )>{}, #member_name, this->member_name, \
+            [&]{ return std::remove_cvref_t<decltype(member_name)>{}; }, []{ return nullptr; } );  \
     }while(false);
 
 /**
@@ -259,11 +276,8 @@
 #define M_VCT_TOOLS_JSON_CONSTRUCTOR_MAP_FIELD_OR(field_name, member_name, default_result, default_range_value) \
     do{ \
         static_assert( std::is_convertible_v<decltype(default_result), std::remove_cvref_t<decltype(member_name)>>, "VCT_TOOLS_JSON: " #member_name " use macros FIELD_OR, default_result must be convertible to member_type. " );  \
-        this->member_name = ( \
-            (_json_value.is_obj() && _json_value.obj().contains( #field_name )) ? \
-            _json_value[ #field_name ].template move_or<std::remove_cvref_t<decltype(member_name)>,std::remove_cvref_t<decltype(default_range_value)>>( default_result, default_range_value ) : \
-            default_result \
-        );  \
+        _json_field( std::integral_constant<std::uint64_t, ::vct::tools::Json::Reader::key_hash( #field_name )>{}, #field_name, this->member_name, \
+            [&]{ return default_result; }, [&]{ return default_range_value; } );  \
     }while(false);
 
 /**
@@ -297,11 +311,8 @@
 #define M_VCT_TOOLS_JSON_CONSTRUCTOR_MAP_FIELD_DEFAULT(field_name, member_name) \
     do {    \
         static_assert( std::is_default_constructible_v<std::remove_cvref_t<decltype(member_name)>>, "VCT_TOOLS_JSON: " #member_name " use macros FIELD_DEFAULT, must is_default_constructible. "    );  \
-        this->member_name = ( \
-            (_json_value.is_obj() && _json_value.obj().contains( #field_name )) ? \
-            _json_value[ #field_name ].template move_or<std::remove_cvref_t<decltype(member_name)>>( std::remove_cvref_t<decltype(member_name)>{} ) : \
-            std::remove_cvref_t<decltype(member_name)>{} \
-        );  \
+        _json_field( std::integral_constant<std::uint64_t, ::vct::tools::Json::Reader::key_hash( #field_name )>{}, #field_name, this->member_name, \
+            [&]{ return std::remove_cvref_t<decltype(member_name)>{}; }, []{ return nullptr; } );  \
     }while(false);
 
 /**
@@ -314,8 +325,14 @@
  *          and initializes class members based on the JSON content. The constructor is noexcept
  *          and uses move semantics for optimal performance.
  *
- * @note The constructor parameter name is _json_value and is available within the macro body.
- *       All field initialization macros should be used within this macro's body.
+ *          It also generates `void read_json(::vct::tools::Json::Reader& reader)`, which reads an object
+ *          from JSON text straight into the members, see `::vct::tools::Json::Reader::parse<class_name>(text)`.
+ *          Keys are dispatched to fields by a compile-time hash, missing fields get the same defaults.
+ *          If a key appears more than once, the first value is kept, same as `::vct::tools::Json::parse`.
+ *
+ * @note The constructor parameter name is _json_value.
+ *       Only the field initialization macros should be used within this macro's body,
+ *       because the body is also expanded in `read_json`.
  *
  * @example
  * @code
@@ -336,7 +353,40 @@
  */
 #define M_VCT_TOOLS_JSON_CONSTRUCTOR_FUNCTION( class_name, ... ) \
     explicit class_name ( ::vct::tools::Json _json_value ) {  \
+        auto _json_field = [&_json_value](auto, const char* _json_name, auto& _json_member, auto _json_default, auto _json_range) { \
+            if (const auto _json_found = _json_value.find( _json_name )) { \
+                _json_member = _json_found->template move_or<std::remove_cvref_t<decltype(_json_member)>, decltype(_json_range())>( _json_default(), _json_range() ); \
+            } else { \
+                _json_member = _json_default(); \
+            } \
+        }; \
         __VA_ARGS__     \
+    } \
+    void read_json( ::vct::tools::Json::Reader& _json_reader ) { \
+        std::size_t _json_count = 0; \
+        { \
+            auto _json_field = [&_json_count](auto, const char*, auto& _json_member, auto _json_default, auto) { \
+                _json_member = _json_default(); \
+                ++_json_count; \
+            }; \
+            __VA_ARGS__ \
+        } \
+        bool _json_small[64]{}; \
+        const auto _json_large = _json_count > 64 ? std::make_unique<bool[]>(_json_count) : nullptr; \
+        bool* const _json_assigned = _json_large ? _json_large.get() : _json_small; \
+        _json_reader.read_object([this, &_json_reader, _json_assigned](const std::uint64_t _json_hash, const std::string_view _json_key) { \
+            bool _json_found = false; \
+            std::size_t _json_index = 0; \
+            auto _json_field = [&](auto _json_id, const char* _json_name, auto& _json_member, auto _json_default, auto _json_range) { \
+                const std::size_t _json_slot = _json_index++; \
+                if (_json_found || _json_assigned[_json_slot] || _json_hash != decltype(_json_id)::value || _json_key != _json_name) return; \
+                _json_found = true; \
+                _json_assigned[_json_slot] = true; \
+                if (!_json_reader.value(_json_member, _json_range())) _json_member = _json_default(); \
+            }; \
+            __VA_ARGS__ \
+            return _json_found; \
+        }); \
     }
 
 /** @} */ // end of JSON_CONSTRUCTOR_MACROS
@@ -39,6 +39,330 @@ namespace vct::tools::json {
         for (int i = 0; i <= 5; ++i) table['a' + i] = 10 + i;
         return table;
     }();
+
+    /**
+     * @brief Check per byte whether `m < byte < n`, result has 0x80 in each matched byte.
+     * @note Non-export. Exact for all bytes, requires `m <= 127` and `n <= 128`.
+     */
+    template<std::unsigned_integral W>
+    constexpr W swar_between(const W x, const W m, const W n) noexcept {
+        constexpr W ones = ~W{} / 255;
+        return (ones * (127 + n) - (x & ones * 127) & ~x & (x & ones * 127) + ones * (127 - m)) & ones * 128;
+    }
+
+    /**
+     * @brief Decode four hexadecimal characters at once (SWAR).
+     * @param ptr Pointer to four readable characters.
+     * @return The decoded value in [0, 0xFFFF], or -1 if any character is not a hex digit.
+     * @note Non-export.
+     */
+    inline std::int32_t hex4_swar(const char* const ptr) noexcept {
+        std::uint32_t word;
+        std::memcpy(&word, ptr, 4);
+        if constexpr (std::endian::native == std::endian::big) word = std::byteswap(word);
+        // now the first character is the lowest byte
+        const std::uint32_t digit = swar_between<std::uint32_t>(word, '0' - 1, '9' + 1);
+        const std::uint32_t alpha = swar_between<std::uint32_t>(word | 0x20202020u, 'a' - 1, 'f' + 1);
+        if ((digit | alpha) != 0x80808080u) return -1;
+        // nibble value of each byte, letters add 9 ('a' & 0xF == 1)
+        const std::uint32_t nibbles = (word & 0x0F0F0F0Fu) + (alpha >> 7) * 9;
+        // [n0, n1, n2, n3] -> [n0n1, n2n3] -> n0n1n2n3
+        const std::uint32_t pairs = (nibbles & 0x000F000Fu) << 4 | (nibbles >> 8 & 0x000F000Fu);
+        return static_cast<std::int32_t>((pairs & 0xFF) << 8 | (pairs >> 16 & 0xFF));
+    }
+
+    /**
+     * @brief Encode a Unicode code point to UTF-8.
+     * @param code_point The code point to encode.
+     * @param buffer The output buffer, at least 4 bytes.
+     * @return The number of bytes written, 0 if the code point is out of range.
+     * @note Non-export.
+     */
+    constexpr std::size_t utf8_encode(const std::uint32_t code_point, char* const buffer) noexcept {
+        if (code_point <= 0x7F) {
+            buffer[0] = static_cast<char>(code_point);
+            return 1;
+        }
+        if (code_point <= 0x7FF) {
+            buffer[0] = static_cast<char>(code_point >> 6 | 0xC0);
+            buffer[1] = static_cast<char>(code_point & 0x3F | 0x80);
+            return 2;
+        }
+        if (code_point <= 0xFFFF) {
+            buffer[0] = static_cast<char>(code_point >> 12 | 0xE0);
+            buffer[1] = static_cast<char>(code_point >> 6 & 0x3F | 0x80);
+            buffer[2] = static_cast<char>(code_point & 0x3F | 0x80);
+            return 3;
+        }
+        if (code_point <= 0x10FFFF) {
+            buffer[0] = static_cast<char>(code_point >> 18 | 0xF0);
+            buffer[1] = static_cast<char>(code_point >> 12 & 0x3F | 0x80);
+            buffer[2] = static_cast<char>(code_point >> 6 & 0x3F | 0x80);
+            buffer[3] = static_cast<char>(code_point & 0x3F | 0x80);
+            return 4;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief A lookup table for serialization escapes.
+     * @note Non-export. `0` means no escape, `u` means `\u00XX`, other values are the escape letter.
+     */
+    constexpr std::array<char, 256> escape_table = [] {
+        std::array<char, 256> table{};
+        for (int i = 0; i < 0x20; ++i) table[i] = 'u';
+        table['\"'] = '\"';
+        table['\\'] = '\\';
+        table['\b'] = 'b';
+        table['\f'] = 'f';
+        table['\n'] = 'n';
+        table['\r'] = 'r';
+        table['\t'] = 't';
+        return table;
+    }();
+
+    /**
+     * @brief Lower-case hexadecimal digits.
+     * @note Non-export.
+     */
+    constexpr std::string_view hex_digits = "0123456789abcdef";
+
+    /**
+     * @brief Load 8 bytes so that the first character is the lowest byte.
+     * @note Non-export.
+     */
+    inline std::uint64_t swar_load(const char* const ptr) noexcept {
+        std::uint64_t word;
+        std::memcpy(&word, ptr, 8);
+        if constexpr (std::endian::native == std::endian::big) word = std::byteswap(word);
+        return word;
+    }
+
+    /**
+     * @brief Find bytes that must be escaped in a JSON string, result has 0x80 in each matched byte.
+     * @note Non-export. Matches control characters, `"` and `\`, exact for all bytes.
+     */
+    constexpr std::uint64_t swar_escape_mask(const std::uint64_t word) noexcept {
+        constexpr std::uint64_t ones = 0x0101010101010101ull;
+        constexpr std::uint64_t low7 = ones * 0x7F;
+        constexpr std::uint64_t high = ones * 0x80;
+        // bytes less than 0x20
+        const std::uint64_t control = ~((word & low7) + ones * (0x80 - 0x20) | word) & high;
+        // bytes equal to `"` or `\`
+        const std::uint64_t quote = word ^ ones * '\"';
+        const std::uint64_t slash = word ^ ones * '\\';
+        const std::uint64_t quote_zero = ~((quote & low7) + low7 | quote) & high;
+        const std::uint64_t slash_zero = ~((slash & low7) + low7 | slash) & high;
+        return control | quote_zero | slash_zero;
+    }
+
+    /**
+     * @brief Find the first character that must be escaped.
+     * @return Pointer to the character, or `end` if there is none.
+     * @note Non-export. Scans 16 bytes per step.
+     */
+    inline const char* find_escape(const char* ptr, const char* const end) noexcept {
+        for (; end - ptr >= 16; ptr += 16) {
+            const std::uint64_t mask0 = swar_escape_mask(swar_load(ptr));
+            const std::uint64_t mask1 = swar_escape_mask(swar_load(ptr + 8));
+            if (mask0) return ptr + (std::countr_zero(mask0) >> 3);
+            if (mask1) return ptr + 8 + (std::countr_zero(mask1) >> 3);
+        }
+        if (end - ptr >= 8) {
+            if (const std::uint64_t mask = swar_escape_mask(swar_load(ptr))) return ptr + (std::countr_zero(mask) >> 3);
+            ptr += 8;
+        }
+        while (ptr != end && escape_table[static_cast<unsigned char>(*ptr)] == 0) ++ptr;
+        return ptr;
+    }
+
+    /**
+     * @brief Escape a string and append it with quotes to a string-like output.
+     * @param out The output, requires `push_back(char)` and `append(const char*, size)`.
+     * @param str The string to escape.
+     * @note Non-export. Clean runs are appended in bulk.
+     */
+    template<typename Out>
+    requires requires (Out& out, const char* ptr, std::size_t len) {
+        out.push_back('"');
+        out.append(ptr, len);
+    }
+    void escape_to(Out& out, const std::string_view str) {
+        out.push_back('\"');
+        const char* ptr = str.data();
+        const char* const end = ptr + str.size();
+        while (ptr != end) {
+            const char* const next = find_escape(ptr, end);
+            if (next != ptr) out.append(ptr, static_cast<std::size_t>(next - ptr));
+            if (next == end) break;
+            const auto c = static_cast<unsigned char>(*next);
+            if (const char letter = escape_table[c]; letter != 'u') {
+                const char sequence[2] = { '\\', letter };
+                out.append(sequence, 2);
+            } else {
+                const char sequence[6] = { '\\', 'u', '0', '0', hex_digits[c >> 4], hex_digits[c & 0xF] };
+                out.append(sequence, 6);
+            }
+            ptr = next + 1;
+        }
+        out.push_back('\"');
+    }
+
+    /**
+     * @brief Get the length of a string after escaping, including quotes.
+     * @note Non-export.
+     */
+    inline std::size_t escaped_size(const std::string_view str) noexcept {
+        std::size_t size = str.size() + 2;
+        const char* ptr = str.data();
+        const char* const end = ptr + str.size();
+        while ((ptr = find_escape(ptr, end)) != end) {
+            size += escape_table[static_cast<unsigned char>(*ptr)] == 'u' ? 5 : 1;
+            ++ptr;
+        }
+        return size;
+    }
+
+    /**
+     * @brief Get the length of a formatted JSON number.
+     * @note Non-export.
+     */
+    inline std::size_t number_size(const double value) {
+        char buffer[24];
+        const auto [ptr, ec]  = std::to_chars(buffer, buffer + 24, value, std::chars_format::general, 17);
+        if(ec != std::errc{}) return std::formatted_size("{:.17}", value);
+        return static_cast<std::size_t>(ptr - buffer);
+    }
+
+    /**
+     * @brief Format a JSON number and append it to a string-like output.
+     * @note Non-export.
+     */
+    template<typename Out>
+    void number_to(Out& out, const double value) {
+        char buffer[24]; // Reserve enough space for typical numbers
+        const auto [ptr, ec]  = std::to_chars(
+            buffer,
+            buffer + 24,
+            value,
+            std::chars_format::general,
+            17
+        );
+        if(ec != std::errc{}) {
+            const auto text = std::format("{:.17}", value);
+            out.append(text.data(), text.size());
+        } else out.append(buffer, static_cast<std::size_t>(ptr - buffer));
+    }
+
+    /**
+     * @brief A string-like output that buffers characters and flushes them to a stream in large blocks.
+     * @note Non-export.
+     * The serializer fills the buffer with plain copies, the stream buffer is only called by `flush()`.
+     * After a failed flush, further output is discarded.
+     */
+    class StreamWriter {
+        static constexpr std::size_t buffer_size = 16384;
+        std::ostream& m_stream;
+        std::size_t m_size{ 0 };
+        bool m_fail{ false };
+        std::array<char, buffer_size> m_buffer;
+
+    public:
+        explicit StreamWriter(std::ostream& out) noexcept : m_stream(out) {}
+        StreamWriter(const StreamWriter&) = delete;
+        StreamWriter& operator=(const StreamWriter&) = delete;
+
+        void push_back(const char c) {
+            if (m_size == buffer_size) flush();
+            m_buffer[m_size++] = c;
+        }
+
+        void append(const char* ptr, std::size_t len) {
+            if (len > buffer_size - m_size) {
+                flush();
+                // large blocks bypass the buffer
+                if (len >= buffer_size) {
+                    if (!m_fail && m_stream.rdbuf()->sputn(ptr, static_cast<std::streamsize>(len)) != static_cast<std::streamsize>(len)) m_fail = true;
+                    return;
+                }
+            }
+            std::memcpy(m_buffer.data() + m_size, ptr, len);
+            m_size += len;
+        }
+
+        void append(std::size_t count, const char c) {
+            while (count > buffer_size - m_size) {
+                const std::size_t part = buffer_size - m_size;
+                std::memset(m_buffer.data() + m_size, c, part);
+                m_size = buffer_size;
+                count -= part;
+                flush();
+            }
+            std::memset(m_buffer.data() + m_size, c, count);
+            m_size += count;
+        }
+
+        /**
+         * @brief Write the buffered characters to the stream.
+         * @return False if the stream failed now or before, the stream's badbit is set.
+         */
+        bool flush() {
+            if (!m_fail && m_size != 0) {
+                if (const std::ostream::sentry sentry{ m_stream };
+                    !sentry || m_stream.rdbuf()->sputn(m_buffer.data(), static_cast<std::streamsize>(m_size)) != static_cast<std::streamsize>(m_size)
+                ) m_fail = true;
+            }
+            m_size = 0;
+            if (m_fail) m_stream.setstate(std::ios::badbit);
+            return !m_fail;
+        }
+    };
+
+    /**
+     * @brief A newline followed by indent characters, each line prefix is a single copy of its head.
+     * @note Non-export. The buffer grows on demand, up to the deepest line written,
+     * so a view returned by `get` is only valid until the next call.
+     */
+    class LinePrefix {
+        std::string m_line;
+        char m_indent_char;
+
+    public:
+        LinePrefix(const char indent_char, const std::uint32_t reserve) : m_indent_char(indent_char) {
+            m_line.assign(std::min<std::size_t>(reserve, 128) + 1, indent_char);
+            m_line.front() = '\n';
+        }
+
+        /**
+         * @brief Get `\n` followed by `tabs` indent characters, valid until the next call.
+         */
+        std::string_view get(const std::size_t tabs) {
+            if (tabs >= m_line.size()) m_line.resize(std::max(tabs + 1, m_line.size() * 2), m_indent_char);
+            return { m_line.data(), tabs + 1 };
+        }
+    };
+
+    /**
+     * @brief Transparent hash for Object keys, allows lookup by `std::string_view` without creating a String.
+     * @note Non-export.
+     */
+    struct KeyHash {
+        using is_transparent = void;
+        std::size_t operator()(const std::string_view key) const noexcept {
+            return std::hash<std::string_view>{}(key);
+        }
+    };
+
+    /**
+     * @brief Concept to check if a type is a map from String to the JSON Container class, other than its Object.
+     * @note Non-export. Such as `std::map<std::string, Json>` with a non-transparent comparator.
+     */
+    template<typename J, typename T>
+    concept object_like = std::ranges::range<T> && requires {
+        requires std::is_same_v<typename T::key_type, typename J::String>;
+        requires std::is_same_v<typename T::mapped_type, J>;
+        requires (!std::is_same_v<T, typename J::Object>);
+    };
 }
 
 /**
@@ -78,7 +402,7 @@ export namespace vct::tools::json {
         std::is_convertible<T, typename J::Number>,
         std::is_convertible<T, typename J::Bool>,
         std::is_convertible<T, typename J::Null>
-    >;
+    > || object_like<J, T>;
 
     /**
      * @brief Concept to check if JSON Container class is constructible from an array-like type.
@@ -181,6 +505,17 @@ export namespace vct::tools::json {
         eUnknownError       ///< Unknown error occurred
     };
 
+    /**
+     * @brief Options for formatted serialization, used by `writef` and `dumpf`.
+     */
+    struct FormatOptions {
+        std::uint16_t space_num{ 2 };           ///< Number of indent characters per level
+        std::uint16_t depth{ 0 };               ///< Initial indentation level
+        std::uint32_t max_space{ 512 };         ///< Maximum number of indent characters in a line
+        char indent_char{ ' ' };                ///< Indent character, `' '` or `'\t'`
+        bool compact_scalar_arrays{ false };    ///< Write arrays without Array/Object elements in one line
+    };
+
     /**
      * @brief Get the name of the JSON data type.
      * @return The name of the JSON data type as a string.
@@ -264,11 +599,12 @@ export namespace vct::tools::json {
         using Array = std::vector<Json, AllocatorType<Json>>;
         /**
          * @brief Json's Object Type, `std::map` or `std::unordered_map`.
-         * @note default is `std::map<std::string, Json>`.
+         * @note default is `std::map<std::string, Json, std::less<>>`.
+         * The comparator and hash are transparent, keys can be looked up by `std::string_view` without allocation.
          */
         using Object = std::conditional_t<UseOrderedMap,
-            std::map<String, Json, std::less<String>, AllocatorType<std::pair<const String, Json>>>,
-            std::unordered_map<String, Json, std::hash<String>, std::equal_to<String>, AllocatorType<std::pair<const String, Json>>>
+            std::map<String, Json, std::less<>, AllocatorType<std::pair<const String, Json>>>,
+            std::unordered_map<String, Json, KeyHash, std::equal_to<>, AllocatorType<std::pair<const String, Json>>>
         >;
 
     protected:
@@ -282,58 +618,6 @@ export namespace vct::tools::json {
         > m_data { Null{} };
 
     private:
-        /**
-         * @brief Escape a string to a string back.
-         * @param out The output string to append the escaped string to.
-         * @param str The string to escape.
-         */
-        static void escape_to(String& out, const std::string_view str) {
-            out.push_back('\"');
-            for (const char c : str) {
-                switch (c) {
-                    case '\\': out.append(R"(\\)"); break;
-                    case '\"': out.append(R"(\")"); break;
-                    case '\r': out.append(R"(\r)"); break;
-                    case '\n': out.append(R"(\n)"); break;
-                    case '\f': out.append(R"(\f)"); break;
-                    case '\t': out.append(R"(\t)"); break;
-                    case '\b': out.append(R"(\b)"); break;
-                    default: {
-                        if (static_cast<unsigned char>(c) < 0x20) {
-                            out.append(std::format("\\u{:04x}", static_cast<unsigned char>(c)));
-                        } else out.push_back(c);
-                    } break;
-                }
-            }
-            out.push_back('"');
-        }
-
-        /**
-         * @brief Escape a string to an out-stream.
-         * @param out The output stream to append the escaped string to.
-         * @param str The string to escape.
-         */
-        static void escape_to(std::ostream& out, const std::string_view str) {
-            out.put('\"');
-            for (const char c : str) {
-                switch (c) {
-                    case '\\': out << R"(\\)"; break;
-                    case '\"': out << R"(\")"; break;
-                    case '\r': out << R"(\r)"; break;
-                    case '\n': out << R"(\n)"; break;
-                    case '\f': out << R"(\f)"; break;
-                    case '\t': out << R"(\t)"; break;
-                    case '\b': out << R"(\b)"; break;
-                    default: {
-                        if (static_cast<unsigned char>(c) < 0x20) {
-                            std::print(out, "\\u{:04x}", static_cast<unsigned char>(c));
-                        } else out.put(c);
-                    } break;
-                }
-            }
-            out.put('\"');
-        }
-
         /**
          * @brief Unescape a Unicode escape sequence in a string, and move ptr.
          * @param out The output string to append the unescaped Unicode character to.
@@ -347,6 +631,31 @@ export namespace vct::tools::json {
             const char_iterator auto end_ptr
         ) {
             // it was in `\uABCD`'s `u` position
+
+            // Fast path for contiguous input, `\uXXXX` or `\uXXXX\uXXXX` is fully inside the buffer.
+            // Anything unusual falls through to the checked path below, which reports errors.
+            if constexpr (std::contiguous_iterator<std::remove_cvref_t<decltype(it)>>) {
+                if (end_ptr - it > 4) {
+                    const char* const ptr = std::to_address(it);
+                    if (const std::int32_t high = hex4_swar(ptr + 1); high >= 0) {
+                        char buffer[4];
+                        if (high < 0xD800 || high > 0xDFFF) {
+                            out.append(buffer, utf8_encode(static_cast<std::uint32_t>(high), buffer));
+                            it += 4;
+                            return true;
+                        }
+                        if (high < 0xDC00 && end_ptr - it > 10 && ptr[5] == '\\' && ptr[6] == 'u') {
+                            if (const std::int32_t low = hex4_swar(ptr + 7); low >= 0xDC00 && low <= 0xDFFF) {
+                                const std::uint32_t code_point = 0x10000 + (static_cast<std::uint32_t>(high - 0xD800) << 10) + static_cast<std::uint32_t>(low - 0xDC00);
+                                out.append(buffer, utf8_encode(code_point, buffer));
+                                it += 10;
+                                return true;
+                            }
+                        }
+                    }
+                }
+            }
+
             ++it;
             if (it == end_ptr) return false;
             // `it` was in `\uXXXX`'s A position
@@ -429,21 +738,10 @@ export namespace vct::tools::json {
             }
 
             // encode the code point to UTF-8
-            if (code_point <= 0x7F) {
-                out.push_back(static_cast<char>(code_point));
-            } else if (code_point <= 0x7FF) {
-                out.push_back(static_cast<char>(code_point >> 6 | 0xC0));
-                out.push_back(static_cast<char>(code_point & 0x3F | 0x80));
-            } else if (code_point <= 0xFFFF) {
-                out.push_back(static_cast<char>(code_point >> 12 | 0xE0));
-                out.push_back(static_cast<char>(code_point >> 6 & 0x3F | 0x80));
-                out.push_back(static_cast<char>(code_point & 0x3F | 0x80));
-            } else if (code_point <= 0x10FFFF) {
-                out.push_back(static_cast<char>(code_point >> 18 | 0xF0));
-                out.push_back(static_cast<char>(code_point >> 12 & 0x3F | 0x80));
-                out.push_back(static_cast<char>(code_point >> 6 & 0x3F | 0x80));
-                out.push_back(static_cast<char>(code_point & 0x3F | 0x80));
-            } else return false;
+            char buffer[4];
+            const std::size_t length = utf8_encode(code_point, buffer);
+            if (length == 0) return false;
+            out.append(buffer, length);
             return true;
         }
 
@@ -452,6 +750,8 @@ export namespace vct::tools::json {
          * @param it The iterator pointing to the current position in the string.
          * @param end_ptr The end iterator of the string.
          * @return An expected String containing the unescaped string, or a ParseError if an error occurred.
+         * @note For contiguous input, the run before the first escape is copied at once,
+         * so strings without escapes (most object keys) are created with their exact size.
          */
         static std::expected<String, ParseError> unescape_next(
             char_iterator auto& it,
@@ -459,7 +759,16 @@ export namespace vct::tools::json {
         ) {
             String res;
             ++it;
-            if (it != end_ptr && *it != '\"')  res.reserve( 128 );
+            if constexpr (std::contiguous_iterator<std::remove_cvref_t<decltype(it)>>) {
+                const char* const begin = std::to_address(it);
+                const char* const stop = find_escape(begin, std::to_address(end_ptr));
+                res.assign(begin, stop);
+                it += stop - begin;
+                if (it != end_ptr && *it == '\"') {
+                    ++it;
+                    return res;
+                }
+            } else if (it != end_ptr && *it != '\"')  res.reserve( 128 );
 
             while (it != end_ptr && *it != '\"') {
                 if (*it == '\\') {
@@ -489,6 +798,113 @@ export namespace vct::tools::json {
             return res;
         }
 
+        /**
+         * @brief Read a number from the input iterator.
+         * @param it The iterator pointing to the first character of the number, it will be moved after the number.
+         * @param end_ptr The end iterator of the input.
+         * @return An expected Number, or a ParseError if an error occurred.
+         */
+        static std::expected<Number, ParseError> number_next(
+            char_iterator auto& it,
+            const char_iterator auto end_ptr
+        ) {
+            std::uint8_t buffer_len{};
+            char buffer[25];    // Reserve enough space for typical numbers
+
+            while(buffer_len < 25 && it != end_ptr &&
+                (std::isdigit(*it)  || *it=='-' || *it=='.' || *it=='e' || *it=='E' || *it=='+')
+            ) buffer[buffer_len++] = *it++;
+            if( buffer_len == 0 || buffer_len == 25 ) return std::unexpected( ParseError::eInvalidNumber );
+
+            Number value;
+            if(const auto [ptr, ec] = std::from_chars(buffer, buffer + buffer_len, value);
+                ec != std::errc{} || ptr != buffer + buffer_len
+            ) return std::unexpected( ParseError::eInvalidNumber );
+            return value;
+        }
+
+        /**
+         * @brief Validate and skip a JSON value without creating it.
+         * @param it The iterator pointing to the first character of the value, it will be moved after the value.
+         * @param end_ptr The end iterator of the input.
+         * @param max_depth The maximum depth of nested JSON objects/arrays allowed.
+         * @return `ParseError::eNone`, or the same error as `reader` for invalid input.
+         * @note Nothing is allocated, strings are scanned with `find_escape` and escapes are only checked.
+         */
+        static ParseError skip_next(
+            std::string_view::const_iterator& it,
+            const std::string_view::const_iterator end_ptr,
+            const std::int32_t max_depth
+        ) {
+            if (max_depth < 0) return ParseError::eDepthExceeded;
+            const auto literal = [&it, end_ptr](const std::string_view word) {
+                if (end_ptr - it < static_cast<std::ptrdiff_t>(word.size()) || std::string_view{ it, it + static_cast<std::ptrdiff_t>(word.size()) } != word) return ParseError::eUnknownFormat;
+                it += static_cast<std::ptrdiff_t>(word.size());
+                return ParseError::eNone;
+            };
+            switch (*it) {
+                case '{': case '[': {
+                    const bool is_object = *it == '{';
+                    const char close = is_object ? '}' : ']';
+                    ++it;
+                    while (it != end_ptr) {
+                        while (it != end_ptr && std::isspace(*it)) ++it;
+                        if (it == end_ptr || *it == close) break;
+                        if (is_object) {
+                            if (*it != '\"') return ParseError::eUnknownFormat;
+                            if (const auto error = skip_next(it, end_ptr, max_depth); error != ParseError::eNone) return error;
+                            while (it != end_ptr && std::isspace(*it)) ++it;
+                            if (it == end_ptr || *it != ':') return ParseError::eUnknownFormat;
+                            ++it;
+                            while (it != end_ptr && std::isspace(*it)) ++it;
+                            if (it == end_ptr) break;
+                        }
+                        if (const auto error = skip_next(it, end_ptr, max_depth - 1); error != ParseError::eNone) return error;
+
+                        while (it != end_ptr && std::isspace(*it)) ++it;
+                        if (it == end_ptr) break;
+                        if (*it == ',') ++it;
+                        else if (*it != close) return ParseError::eUnknownFormat;
+                    }
+                    if (it == end_ptr) return is_object ? ParseError::eUnclosedObject : ParseError::eUnclosedArray;
+                    ++it;
+                } break;
+                case '\"': {
+                    ++it;
+                    while (true) {
+                        it += find_escape(std::to_address(it), std::to_address(end_ptr)) - std::to_address(it);
+                        if (it == end_ptr) return ParseError::eUnclosedString;
+                        if (*it == '\"') break;
+                        if (*it != '\\') {
+                            // other control characters are accepted, same as `unescape_next`
+                            if (*it == '\b' || *it == '\n' || *it == '\f' || *it == '\r') return ParseError::eIllegalEscape;
+                            ++it;
+                            continue;
+                        }
+                        if (++it == end_ptr) return ParseError::eUnclosedString;
+                        switch (*it) {
+                            case '\"': case '\\': case 'n': case 'r': case 't': case 'f': case 'b': break;
+                            case 'u': case 'U': {
+                                String code_point;  // at most 4 bytes, never allocates
+                                if (!unescape_unicode_next(code_point, it, end_ptr)) return ParseError::eIllegalEscape;
+                            } break;
+                            default: return ParseError::eIllegalEscape;
+                        }
+                        ++it;
+                    }
+                    ++it;
+                } break;
+                case 't': return literal("true");
+                case 'f': return literal("false");
+                case 'n': return literal("null");
+                default: {
+                    if (*it == 'e' || *it == 'E') return ParseError::eUnknownFormat;
+                    if (const auto value = number_next(it, end_ptr); !value) return value.error();
+                } break;
+            }
+            return ParseError::eNone;
+        }
+
         /**
          * @brief Read a JSON value from the input iterator and create Json Object.
          * @param it The iterator pointing to the current position in the input.
@@ -603,67 +1019,321 @@ export namespace vct::tools::json {
                 default: {
                     if(* it == 'e' || *it == 'E' ) return std::unexpected( ParseError::eUnknownFormat );
                     // begin with e/E is invalid, other invalid type will be handled after
-
-                    // number
-                    std::uint8_t buffer_len{};
-                    char buffer[25];    // Reserve enough space for typical numbers
-                    // std::array<char, 24> buffer;
-
-                    while(buffer_len < 25 && it != end_ptr &&
-                        (std::isdigit(*it)  || *it=='-' || *it=='.' || *it=='e' || *it=='E' || *it=='+')
-                    ) buffer[buffer_len++] = *it++;
-                    if( buffer_len == 0 || buffer_len == 25 ) return std::unexpected( ParseError::eInvalidNumber );
-
-                    Number value;
-                    if(const auto [ptr, ec] = std::from_chars(buffer, buffer + buffer_len, value);
-                        ec != std::errc{} || ptr != buffer + buffer_len
-                    ) return std::unexpected( ParseError::eInvalidNumber );
-
-                    json = value;
+                    auto value = number_next(it, end_ptr);
+                    if(!value) return std::unexpected( value.error() );
+                    json = *value;
                 } break;
             }
             return json;
         }
 
-    public:
         /**
-         * @brief Get the type of the JSON data.
-         * @return The type of the JSON data as a Type enum value.
+         * @brief Write the JSON data to a string-like output.
+         * @param out The output, a `String` or a buffered stream writer.
          */
-        [[nodiscard]]
-        constexpr Type type() const noexcept { return static_cast<Type>(m_data.index()); }
+        template<typename Out>
+        void write_to(Out& out) const {
+            switch (type()) {
+                case Type::eObject: {
+                    out.push_back('{');
+                    for(bool first = true;
+                        const auto& [key, val] : std::get<Object>(m_data)
+                    ) {
+                        if(!first) out.push_back(',');
+                        else first = false;
+                        escape_to(out, key);
+                        out.push_back(':');
+                        val.write_to(out);
+                    }
+                    out.push_back('}');
+                } break;
+                case Type::eArray: {
+                    out.push_back('[');
+                    for(bool first = true;
+                        const auto& val : std::get<Array>(m_data)
+                    ) {
+                        if(!first) out.push_back(',');
+                        else first = false;
+                        val.write_to(out);
+                    }
+                    out.push_back(']');
+                } break;
+                case Type::eBool:
+                    if (std::get<Bool>(m_data)) out.append("true", 4);
+                    else out.append("false", 5);
+                    break;
+                case Type::eNull:
+                    out.append("null", 4);
+                    break;
+                case Type::eString:
+                    escape_to(out, std::get<String>(m_data));
+                    break;
+                case Type::eNumber:
+                    number_to(out, std::get<Number>(m_data));
+                    break;
+            }
+        }
 
         /**
-         * @brief Check if the JSON data is of type Null.
+         * @brief Check if an array is written in one line by `compact_scalar_arrays`.
          */
         [[nodiscard]]
-        constexpr bool is_nul() const noexcept { return type() == Type::eNull; }
+        static bool is_scalar_array(const Array& array) noexcept {
+            return std::ranges::none_of(array, [](const Json& val) { return val.is_arr() || val.is_obj(); });
+        }
 
         /**
-         * @brief Check if the JSON data is of type Bool.
+         * @brief Write the JSON data to a string-like output with formatting.
+         * @param out The output, a `String` or a buffered stream writer.
+         * @param prefix The cached line prefixes.
+         * @param options The format options, `depth` is ignored.
+         * @param tabs The number of indent characters of the children's lines.
+         * @return True if the writing was successful, false if it exceeded max_space.
          */
-        [[nodiscard]]
-        constexpr bool is_bol() const noexcept { return type() == Type::eBool; }
+        template<typename Out>
+        Bool writef_to(
+            Out& out,
+            LinePrefix& prefix,
+            const FormatOptions& options,
+            const std::size_t tabs
+        ) const {
+            if(tabs > options.max_space) return false;
 
-        /**
-         * @brief Check if the JSON data is of type Number.
-         */
-        [[nodiscard]]
-        constexpr bool is_num() const noexcept { return type() == Type::eNumber; }
+            switch (type()) {
+                case Type::eObject: {
+                    const auto& object = std::get<Object>(m_data);
+                    out.push_back('{');
+                    if (object.empty()) {
+                        out.push_back('}');
+                        break;
+                    }
+                    bool first = true;
+                    for(const auto& [key, val] : object) {
+                        if(!first) out.push_back(',');
+                        else first = false;
+                        // fetched again for each member, a deeper child may have grown the buffer
+                        const std::string_view line = prefix.get(tabs);
+                        out.append(line.data(), line.size());
+                        escape_to(out, key);
+                        out.append(": ", 2);
+                        if(!val.writef_to(out, prefix, options, tabs + options.space_num)) return false;
+                    }
+                    const std::string_view last = prefix.get(tabs - options.space_num);
+                    out.append(last.data(), last.size());
+                    out.push_back('}');
+                } break;
+                case Type::eArray: {
+                    const auto& array = std::get<Array>(m_data);
+                    out.push_back('[');
+                    if (array.empty()) {
+                        out.push_back(']');
+                        break;
+                    }
+                    if (options.compact_scalar_arrays && is_scalar_array(array)) {
+                        bool first = true;
+                        for (const auto& val : array) {
+                            if(!first) out.append(", ", 2);
+                            else first = false;
+                            val.write_to(out);
+                        }
+                        out.push_back(']');
+                        break;
+                    }
+                    bool first = true;
+                    for (const auto& val : array) {
+                        if(!first) out.push_back(',');
+                        else first = false;
+                        const std::string_view line = prefix.get(tabs);
+                        out.append(line.data(), line.size());
+                        if(!val.writef_to(out, prefix, options, tabs + options.space_num)) return false;
+                    }
+                    const std::string_view last = prefix.get(tabs - options.space_num);
+                    out.append(last.data(), last.size());
+                    out.push_back(']');
+                } break;
+                default:
+                    write_to(out);
+                    break;
+            }
+            return true;
+        }
 
         /**
-         * @brief Check if the JSON data is of type String.
+         * @brief Write the JSON data to a string-like output with formatting, from the top level.
          */
-        [[nodiscard]]
-        constexpr bool is_str() const noexcept { return type() == Type::eString; }
+        template<typename Out>
+        Bool writef_to(Out& out, const FormatOptions& options) const {
+            const std::size_t tabs = static_cast<std::size_t>(options.depth) * options.space_num + options.space_num;
+            LinePrefix prefix{ options.indent_char, options.max_space };
+            return writef_to(out, prefix, options, tabs);
+        }
 
         /**
-         * @brief Check if the JSON data is of type Array.
+         * @brief Get the exact length of formatted output, `tabs` is the indentation of the children's lines.
          */
         [[nodiscard]]
-        constexpr bool is_arr() const noexcept { return type() == Type::eArray; }
-
-        /**
+        std::size_t serialized_size_pretty(const FormatOptions& options, const std::size_t tabs) const {
+            switch (type()) {
+                case Type::eObject: {
+                    const auto& object = std::get<Object>(m_data);
+                    if (object.empty()) return 2;
+                    // braces, commas, a line per member and the closing line
+                    std::size_t size = 2 + object.size() - 1 + object.size() * (1 + tabs) + 1 + tabs - options.space_num;
+                    for (const auto& [key, val] : object) {
+                        size += escaped_size(key) + 2 + val.serialized_size_pretty(options, tabs + options.space_num);
+                    }
+                    return size;
+                }
+                case Type::eArray: {
+                    const auto& array = std::get<Array>(m_data);
+                    if (array.empty()) return 2;
+                    if (options.compact_scalar_arrays && is_scalar_array(array)) {
+                        std::size_t size = 2 + (array.size() - 1) * 2;
+                        for (const auto& val : array) size += val.serialized_size();
+                        return size;
+                    }
+                    std::size_t size = 2 + array.size() - 1 + array.size() * (1 + tabs) + 1 + tabs - options.space_num;
+                    for (const auto& val : array) size += val.serialized_size_pretty(options, tabs + options.space_num);
+                    return size;
+                }
+                default: return serialized_size();
+            }
+        }
+
+        /**
+         * @brief Check if the JSON data is a non-empty Array or Object.
+         */
+        [[nodiscard]]
+        bool has_children() const noexcept {
+            if (const auto array = std::get_if<Array>(&m_data)) return !array->empty();
+            if (const auto object = std::get_if<Object>(&m_data)) return !object->empty();
+            return false;
+        }
+
+        /**
+         * @brief Nesting depth that `destroy_children` handles by recursion, deeper subtrees use a work list.
+         */
+        static constexpr std::uint32_t destroy_depth = 64;
+
+        /**
+         * @brief Destroy the children of `node`, leaving it an empty container.
+         * @details Nested containers are emptied by recursion up to `destroy_depth` levels, which needs no allocation.
+         * A subtree below that level is torn down through a work list, so the stack usage stays bounded.
+         */
+        static void destroy_children(Json& node, const std::uint32_t depth) noexcept {
+            const auto release = [depth](Json& child) noexcept {
+                if (!child.has_children()) return;
+                if (depth < destroy_depth) {
+                    destroy_children(child, depth + 1);
+                    return;
+                }
+                Array pending;
+                take_children(child, pending);
+                while (!pending.empty()) {
+                    Json next = std::move(pending.back());
+                    pending.pop_back();
+                    take_children(next, pending);
+                }
+            };
+            if (auto array = std::get_if<Array>(&node.m_data)) {
+                for (auto& child : *array) release(child);
+                array->clear();
+            } else if (auto object = std::get_if<Object>(&node.m_data)) {
+                for (auto& [key, child] : *object) release(child);
+                object->clear();
+            }
+        }
+
+        /**
+         * @brief Move the nested containers of `node` to `pending` and destroy the rest of its children.
+         * @note If the work list cannot grow, the child is destroyed recursively instead.
+         */
+        static void take_children(Json& node, Array& pending) noexcept {
+            const auto take = [&pending](Json& child) noexcept {
+                if (!child.has_children()) return;
+                try {
+                    pending.push_back(std::move(child));
+                } catch (...) {
+                    child.m_data = Null{};  // rare, falls back to recursive destruction
+                }
+            };
+            if (auto array = std::get_if<Array>(&node.m_data)) {
+                for (auto& child : *array) take(child);
+                array->clear();
+            } else if (auto object = std::get_if<Object>(&node.m_data)) {
+                for (auto& [key, child] : *object) take(child);
+                object->clear();
+            }
+        }
+
+        /**
+         * @brief Convert an array whose elements are all numbers to an arithmetic or enum range in one pass.
+         * @param array The source array.
+         * @param result The empty destination.
+         * @return False without touching `result` if any element is not a Number, the caller falls back to per-element conversion.
+         * @note The types are checked once for the whole array, the destination is sized once,
+         * and contiguous destinations are filled through a pointer.
+         */
+        template<typename T>
+        static bool numbers_to(const Array& array, T& result) {
+            using V = typename T::value_type;
+            if (!std::ranges::all_of(array, [](const Json& val) { return val.is_num(); })) return false;
+            const auto convert = [](const Json& val) {
+                const Number number = *std::get_if<Number>(&val.m_data);
+                // same results as `to_if<V>` on each element, bool is `number != 0` there, not rounded
+                if constexpr (std::is_floating_point_v<V> || std::is_same_v<V, bool>) return static_cast<V>(number);
+                else return static_cast<V>(std::llround(number));
+            };
+            if constexpr (std::ranges::contiguous_range<T> && requires { result.resize(array.size()); }) {
+                result.resize(array.size());
+                V* const out = std::ranges::data(result);
+                for (std::size_t i = 0; i < array.size(); ++i) out[i] = convert(array[i]);
+            } else {
+                if constexpr (requires { result.reserve(array.size()); }) result.reserve(array.size());
+                for (const auto& val : array) result.emplace_back(convert(val));
+            }
+            return true;
+        }
+
+    public:
+        /**
+         * @brief Get the type of the JSON data.
+         * @return The type of the JSON data as a Type enum value.
+         */
+        [[nodiscard]]
+        constexpr Type type() const noexcept { return static_cast<Type>(m_data.index()); }
+
+        /**
+         * @brief Check if the JSON data is of type Null.
+         */
+        [[nodiscard]]
+        constexpr bool is_nul() const noexcept { return type() == Type::eNull; }
+
+        /**
+         * @brief Check if the JSON data is of type Bool.
+         */
+        [[nodiscard]]
+        constexpr bool is_bol() const noexcept { return type() == Type::eBool; }
+
+        /**
+         * @brief Check if the JSON data is of type Number.
+         */
+        [[nodiscard]]
+        constexpr bool is_num() const noexcept { return type() == Type::eNumber; }
+
+        /**
+         * @brief Check if the JSON data is of type String.
+         */
+        [[nodiscard]]
+        constexpr bool is_str() const noexcept { return type() == Type::eString; }
+
+        /**
+         * @brief Check if the JSON data is of type Array.
+         */
+        [[nodiscard]]
+        constexpr bool is_arr() const noexcept { return type() == Type::eArray; }
+
+        /**
          * @brief Check if the JSON data is of type Object.
          */
         [[nodiscard]]
@@ -753,9 +1423,15 @@ export namespace vct::tools::json {
          */
         constexpr Json() noexcept = default;
         /**
-         * @brief Destructor for Json, no special cleanup needed.
+         * @brief Destructor for Json, the stack usage is bounded for any nesting depth.
+         * @details
+         * Children are destroyed in place by recursion up to a fixed depth, without allocation,
+         * so wide and shallow trees cost the same as a plain recursive destructor.
+         * Only subtrees nested deeper than that are moved onto a work list and released iteratively.
          */
-        ~Json() noexcept = default;
+        ~Json() noexcept {
+            if (has_children()) destroy_children(*this, 0);
+        }
         /**
          * @brief Copy constructor for Json, uses default copy semantics.
          */
@@ -768,10 +1444,11 @@ export namespace vct::tools::json {
         /**
          * @brief Move constructor for Json, transfers ownership of data.
          * @param other The Json object to move from, will be set to Null.
+         * @note The data is move-constructed directly, without a default-constructed Null in between.
+         * It is `noexcept`, so `std::vector<Json>` moves (never copies) elements when it grows.
          */
-        Json(Json&& other) noexcept {
-            m_data = std::move(other.m_data);
-            other.m_data = Null{};
+        Json(Json&& other) noexcept : m_data{ std::move(other.m_data) } {
+            other.m_data.template emplace<Null>();
         }
         /**
          * @brief Move assignment operator for Json, transfers ownership of data.
@@ -780,7 +1457,7 @@ export namespace vct::tools::json {
         Json& operator=(Json&& other) noexcept {
             if (this == &other) return *this;
             m_data = std::move(other.m_data);
-            other.m_data = Null{};
+            other.m_data.template emplace<Null>();
             return *this;
         }
 
@@ -803,20 +1480,23 @@ export namespace vct::tools::json {
                 std::is_same_v<std::remove_cvref_t<T>, Object>
             ))
         ) {
-            if constexpr(std::is_same_v<T, Null>) {
+            if constexpr(std::is_same_v<std::remove_cvref_t<T>, Null>) {
                 m_data = Null{};
-            } else if constexpr(std::is_same_v<T, Bool>) {
+            } else if constexpr(std::is_same_v<std::remove_cvref_t<T>, Bool>) {
                 m_data = other;
-            } else if constexpr(std::is_same_v<T, Number>) {
+            } else if constexpr(std::is_same_v<std::remove_cvref_t<T>, Number>) {
                 m_data = other;
-            } else if constexpr(std::is_same_v<T, String>) {
+            } else if constexpr(std::is_same_v<std::remove_cvref_t<T>, String>) {
                 m_data = std::forward<T>(other);
-            } else if constexpr(std::is_same_v<T, Array>) {
+            } else if constexpr(std::is_same_v<std::remove_cvref_t<T>, Array>) {
                 m_data = std::forward<T>(other);
-            } else if constexpr(std::is_same_v<T, Object>) {
+            } else if constexpr(std::is_same_v<std::remove_cvref_t<T>, Object>) {
                 m_data = std::forward<T>(other);
-            } else if constexpr(std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+            } else if constexpr(std::is_arithmetic_v<std::remove_cvref_t<T>> || std::is_enum_v<std::remove_cvref_t<T>>) {
                 m_data = static_cast<Number>(other);
+            } else if constexpr(object_like<Json, std::remove_cvref_t<T>>) {
+                if constexpr (std::is_rvalue_reference_v<T&&>) m_data = Object( std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()) );
+                else m_data = Object( other.begin(), other.end() );
             } else if constexpr(std::is_convertible_v<T, String>) {
                 m_data = static_cast<String>(std::forward<T>(other));
             } else if constexpr(std::is_convertible_v<T, Object>) {
@@ -851,20 +1531,23 @@ export namespace vct::tools::json {
                 std::is_same_v<std::remove_cvref_t<T>, Object>
             ))
         ) {
-            if constexpr(std::is_same_v<T, Null>) {
+            if constexpr(std::is_same_v<std::remove_cvref_t<T>, Null>) {
                 m_data = Null{};
-            } else if constexpr(std::is_same_v<T, Bool>) {
+            } else if constexpr(std::is_same_v<std::remove_cvref_t<T>, Bool>) {
                 m_data = other;
-            } else if constexpr(std::is_same_v<T, Number>) {
+            } else if constexpr(std::is_same_v<std::remove_cvref_t<T>, Number>) {
                 m_data = other;
-            } else if constexpr(std::is_same_v<T, String>) {
+            } else if constexpr(std::is_same_v<std::remove_cvref_t<T>, String>) {
                 m_data = std::forward<T>(other);
-            } else if constexpr(std::is_same_v<T, Array>) {
+            } else if constexpr(std::is_same_v<std::remove_cvref_t<T>, Array>) {
                 m_data = std::forward<T>(other);
-            } else if constexpr(std::is_same_v<T, Object>) {
+            } else if constexpr(std::is_same_v<std::remove_cvref_t<T>, Object>) {
                 m_data = std::forward<T>(other);
-            } else if constexpr(std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+            } else if constexpr(std::is_arithmetic_v<std::remove_cvref_t<T>> || std::is_enum_v<std::remove_cvref_t<T>>) {
                 m_data = static_cast<Number>(other);
+            } else if constexpr(object_like<Json, std::remove_cvref_t<T>>) {
+                if constexpr (std::is_rvalue_reference_v<T&&>) m_data = Object( std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()) );
+                else m_data = Object( other.begin(), other.end() );
             } else if constexpr(std::is_convertible_v<T, String>) {
                 m_data = static_cast<String>(std::forward<T>(other));
             } else if constexpr(std::is_convertible_v<T, Object>) {
@@ -933,11 +1616,23 @@ export namespace vct::tools::json {
 
         /**
          * @brief Accessor for JSON data using the subscript operator.
+         * @note Keys are looked up by `std::string_view`, a String is only created when a new key is inserted.
          */
         [[nodiscard]]
-        Json& operator[](const String& key) { return std::get<Object>(m_data)[key]; }
+        Json& operator[](const std::string_view key) {
+            auto& object = std::get<Object>(m_data);
+            if constexpr (UseOrderedMap) {
+                auto it = object.lower_bound(key);
+                if (it == object.end() || it->first != key) it = object.emplace_hint(it, String{ key }, Json{});
+                return it->second;
+            } else {
+                auto it = object.find(key);
+                if (it == object.end()) it = object.emplace(String{ key }, Json{}).first;
+                return it->second;
+            }
+        }
         [[nodiscard]]
-        const Json& operator[](const String& key) const { return std::get<Object>(m_data).at(key); }
+        const Json& operator[](const std::string_view key) const { return at(key); }
         [[nodiscard]]
         Json& operator[](const std::size_t index) { return std::get<Array>(m_data)[index]; }
         [[nodiscard]]
@@ -947,131 +1642,137 @@ export namespace vct::tools::json {
          * @brief Accessor for JSON data using the at() method.
          */
         [[nodiscard]]
-        Json& at(const String& key) { return std::get<Object>(m_data).at(key); }
+        Json& at(const std::string_view key) {
+            auto& object = std::get<Object>(m_data);
+            const auto it = object.find(key);
+            if (it == object.end()) throw std::out_of_range("Json::at: key not found");
+            return it->second;
+        }
         [[nodiscard]]
-        const Json& at(const String& key) const { return std::get<Object>(m_data).at(key); }
+        const Json& at(const std::string_view key) const {
+            const auto& object = std::get<Object>(m_data);
+            const auto it = object.find(key);
+            if (it == object.end()) throw std::out_of_range("Json::at: key not found");
+            return it->second;
+        }
         [[nodiscard]]
         Json& at(const std::size_t index) { return std::get<Array>(m_data).at(index); }
         [[nodiscard]]
         const Json& at(const std::size_t index) const { return std::get<Array>(m_data).at(index); }
 
+        /**
+         * @brief Find a key in the JSON object, the key is not copied to a String.
+         * @param key The key to find.
+         * @return Pointer to the value, nullptr if the JSON is not an object or the key does not exist.
+         */
+        [[nodiscard]]
+        Json* find(const std::string_view key) noexcept {
+            if (type() != Type::eObject) return nullptr;
+            auto& object = std::get<Object>(m_data);
+            const auto it = object.find(key);
+            return it == object.end() ? nullptr : &it->second;
+        }
+        [[nodiscard]]
+        const Json* find(const std::string_view key) const noexcept {
+            if (type() != Type::eObject) return nullptr;
+            const auto& object = std::get<Object>(m_data);
+            const auto it = object.find(key);
+            return it == object.end() ? nullptr : &it->second;
+        }
+
         /**
          * @brief Write the JSON data to a string back.
          */
         void write(String& out) const {
-            switch (type()) {
-                case Type::eObject: {
-                    out.push_back('{');
-                    for (const auto& [key, val] : std::get<Object>(m_data)) {
-                        escape_to(out, key);
-                        out.push_back(':');
-                        val.write(out);
-                        out.push_back(',');
-                    }
-                    if (*out.rbegin() == ',') *out.rbegin() = '}';
-                    else out.push_back('}');
-                } break;
-                case Type::eArray: {
-                    out.push_back('[');
-                    for (const auto& val : std::get<Array>(m_data)) {
-                        val.write(out);
-                        out.push_back(',');
-                    }
-                    if (*out.rbegin() == ',') *out.rbegin() = ']';
-                    else out.push_back(']');
-                } break;
-                case Type::eBool:
-                    out.append(std::get<Bool>(m_data) ? "true" : "false");
-                    break;
-                case Type::eNull:
-                    out.append("null");
-                    break;
-                case Type::eString:
-                    escape_to(out, std::get<String>(m_data));
-                    break;
-                case Type::eNumber: {
-                    char buffer[24]; // Reserve enough space for typical numbers
-                    const auto [ptr, ec]  = std::to_chars(
-                        buffer,
-                        buffer + 24,
-                        std::get<Number>(m_data),
-                        std::chars_format::general,
-                        17
-                    );
-                    if(ec != std::errc{}) {
-                        out.append(std::format("{:.17}",std::get<Number>(m_data)));
-                    } else out.append(buffer, ptr);
-                } break;
-            }
+            write_to(out);
         }
 
         /**
          * @brief Write the JSON data to an output stream.
+         * @note Output is collected in an internal buffer and written to the stream buffer in large blocks.
          */
         void write(std::ostream& out) const {
             if(out.fail()) return;
+            StreamWriter writer{ out };
+            write_to(writer);
+            writer.flush();
+        }
+
+        /**
+         * @brief Get the exact length of `dump()` without serializing.
+         */
+        [[nodiscard]]
+        std::size_t serialized_size() const {
             switch (type()) {
                 case Type::eObject: {
-                    out.put('{');
-                    for(bool first = true;
-                        const auto& [key, val] : std::get<Object>(m_data)
-                    ) {
-                        if(!first) out.put(',');
-                        else first = false;
-                        escape_to(out, key);
-                        out.put(':');
-                        val.write(out);
-                        if(out.fail()) return;
+                    const auto& object = std::get<Object>(m_data);
+                    std::size_t size = object.empty() ? 2 : object.size() + 1; // braces and commas
+                    for (const auto& [key, val] : object) {
+                        size += escaped_size(key) + 1 + val.serialized_size();
                     }
-                    out.put('}');
-                } break;
+                    return size;
+                }
                 case Type::eArray: {
-                    out.put('[');
-                    for(bool first = true;
-                        const auto& val : std::get<Array>(m_data)
-                    ) {
-                        if(!first) out.put(',');
-                        else first = false;
-                        val.write(out);
-                        if(out.fail()) return;
-                    }
-                    out.put(']');
-                } break;
-                case Type::eBool:
-                    out << (std::get<Bool>(m_data) ? "true" : "false");
-                    break;
-                case Type::eNull:
-                    out << "null";
-                    break;
-                case Type::eString:
-                    escape_to(out, std::get<String>(m_data));
-                    break;
-                case Type::eNumber: {
-                    char buffer[24]; // Reserve enough space for typical numbers
-                    const auto [ptr, ec]  = std::to_chars(
-                        buffer,
-                        buffer + 24,
-                        std::get<Number>(m_data),
-                        std::chars_format::general,
-                        17
-                    );
-                    if(ec != std::errc{}) {
-                        std::print(out, "{:.17}", std::get<Number>(m_data));
-                    } else out.write(buffer, static_cast<std::size_t>(ptr-buffer));
-                } break;
+                    const auto& array = std::get<Array>(m_data);
+                    std::size_t size = array.empty() ? 2 : array.size() + 1; // brackets and commas
+                    for (const auto& val : array) size += val.serialized_size();
+                    return size;
+                }
+                case Type::eBool: return std::get<Bool>(m_data) ? 4 : 5;
+                case Type::eNull: return 4;
+                case Type::eString: return escaped_size(std::get<String>(m_data));
+                case Type::eNumber: return number_size(std::get<Number>(m_data));
             }
+            return 0;
+        }
+
+        /**
+         * @brief Get the exact length of `dumpf(options)` without serializing.
+         * @param options The format options.
+         * @note `max_space` is not checked, the result is the length if `dumpf` succeeds.
+         */
+        [[nodiscard]]
+        std::size_t serialized_size_pretty(const FormatOptions& options) const {
+            return serialized_size_pretty(options, static_cast<std::size_t>(options.depth) * options.space_num + options.space_num);
+        }
+
+        /**
+         * @brief Get the exact length of `dumpf(space_num, depth)` without serializing.
+         * @param space_num The number of spaces to use for indentation (default is 2).
+         * @param depth The current depth of indentation (default is 0).
+         * @note `max_space` is not checked, the result is the length if `dumpf` succeeds.
+         */
+        [[nodiscard]]
+        std::size_t serialized_size_pretty(
+            const std::uint16_t space_num = 2,
+            const std::uint16_t depth = 0
+        ) const {
+            return serialized_size_pretty(FormatOptions{ .space_num = space_num, .depth = depth });
         }
 
         /**
          * @brief Dump the JSON data to a string.
+         * @note The result is allocated once, with the size from `serialized_size()`.
+         * To reuse a buffer between calls, `clear()` it and use `write(String&)` instead.
          */
         [[nodiscard]]
         String dump() const {
             String res;
+            res.reserve(serialized_size());
             this->write(res);
             return res;
         }
 
+        /**
+         * @brief Write the JSON data to a string with formatting.
+         * @param out The output string to write to.
+         * @param options The format options, see `FormatOptions`.
+         * @return True if the writing was successful, false if it exceeded max_space.
+         */
+        Bool writef(String& out, const FormatOptions& options) const {
+            return writef_to(out, options);
+        }
+
         /**
          * @brief Write the JSON data to a string with formatting.
          * @param out The output string to write to.
@@ -1086,64 +1787,21 @@ export namespace vct::tools::json {
             const std::uint16_t depth = 0,
             const std::uint32_t max_space = 512
         ) const {
-            const std::uint32_t tabs  = depth * space_num + space_num;
-            if(tabs > max_space) return false;
+            return writef_to(out, FormatOptions{ .space_num = space_num, .depth = depth, .max_space = max_space });
+        }
 
-            switch (type()) {
-                case Type::eObject: {
-                    out.push_back('{');
-                    for (const auto& [key, val] : std::get<Object>(m_data)) {
-                        out.push_back('\n');
-                        out.append(tabs, ' ');
-                        escape_to(out, key);
-                        out.append(": ");
-                        if(!val.writef(out, space_num, depth + 1, max_space)) return false;
-                        out.push_back(',');
-                    }
-                    if (*out.rbegin() == ',') *out.rbegin() = '\n';
-                    if(!std::get<Object>(m_data).empty()){
-                        out.append(tabs - space_num, ' ');
-                    }
-                    out.push_back('}');
-                } break;
-                case Type::eArray: {
-                    out.push_back('[');
-                    for (const auto& val : std::get<Array>(m_data)) {
-                        out.push_back('\n');
-                        out.append(tabs, ' ');
-                        if(!val.writef(out, space_num, depth + 1, max_space)) return false;
-                        out.push_back(',');
-                    }
-                    if (*out.rbegin() == ',') *out.rbegin() = '\n';
-                    if(!std::get<Array>(m_data).empty()){
-                        out.append(tabs - space_num, ' ');
-                    }
-                    out.push_back(']');
-                } break;
-                case Type::eBool:
-                    out.append(std::get<Bool>(m_data) ? "true" : "false");
-                    break;
-                case Type::eNull:
-                    out.append("null");
-                    break;
-                case Type::eString:
-                    escape_to(out, std::get<String>(m_data));
-                    break;
-                case Type::eNumber: {
-                    char buffer[24]; // Reserve enough space for typical numbers
-                    const auto [ptr, ec]  = std::to_chars(
-                        buffer,
-                        buffer + 24,
-                        std::get<Number>(m_data),
-                        std::chars_format::general,
-                        17
-                    );
-                    if(ec != std::errc{}) {
-                        out.append(std::format("{:.17}",std::get<Number>(m_data)));
-                    } else out.append(buffer, ptr);
-                } break;
-            }
-            return true;
+        /**
+         * @brief Write the JSON data to an output stream with formatting.
+         * @param out The output stream to write to.
+         * @param options The format options, see `FormatOptions`.
+         * @return True if the writing was successful, false if it exceeded max_space.
+         * @note Output is collected in an internal buffer and written to the stream buffer in large blocks.
+         */
+        Bool writef(std::ostream& out, const FormatOptions& options) const {
+            if(out.fail()) return false;
+            StreamWriter writer{ out };
+            const Bool result = writef_to(writer, options);
+            return writer.flush() && result;
         }
 
         /**
@@ -1153,6 +1811,7 @@ export namespace vct::tools::json {
          * @param depth The current depth of indentation (default is 0).
          * @param max_space The maximum number of spaces allowed for indentation in a line (default is 512).
          * @return True if the writing was successful, false if it exceeded max_space.
+         * @note Output is collected in an internal buffer and written to the stream buffer in large blocks.
          */
         Bool writef(
             std::ostream& out,
@@ -1160,71 +1819,21 @@ export namespace vct::tools::json {
             const std::uint16_t depth = 0,
             const std::uint32_t max_space = 512
         ) const {
-            if(out.fail()) return false;
-            const std::uint32_t tabs  = depth * space_num + space_num;
-            if(tabs > max_space) return false;
+            return writef(out, FormatOptions{ .space_num = space_num, .depth = depth, .max_space = max_space });
+        }
 
-            switch (type()) {
-                case Type::eObject: {
-                    out.put('{');
-                    bool first = true;
-                    for(const auto& [key, val] : std::get<Object>(m_data)) {
-                        if(!first) out.put(',');
-                        else first = false;
-                        out.put('\n');
-                        out << std::setfill(' ') << std::setw(tabs) << "";
-                        escape_to(out, key);
-                        out.put(':');
-                        out.put(' ');
-                        if(!val.writef(out, space_num, depth + 1, max_space)) return false;
-                    }
-                    if(!first) out.put('\n');
-                    if(!std::get<Object>(m_data).empty()){
-                        out << std::setfill(' ') << std::setw(tabs - space_num) << "";
-                    }
-                    out.put('}');
-                } break;
-                case Type::eArray: {
-                    out.put('[');
-                    bool first = true;
-                    for (const auto& val : std::get<Array>(m_data)) {
-                        if(!first) out.put(',');
-                        else first = false;
-                        out.put('\n');
-                        out << std::setfill(' ') << std::setw(tabs) << "";
-                        if(!val.writef(out, space_num, depth + 1, max_space)) return false;
-                    }
-                    if(!first) out.put('\n');
-                    if(!std::get<Array>(m_data).empty()){
-                        out << std::setfill(' ') << std::setw(tabs - space_num) << "";
-                    }
-                    out.put(']');
-                } break;
-                case Type::eBool:
-                    out << (std::get<Bool>(m_data) ? "true" : "false");
-                    break;
-                case Type::eNull:
-                    out << "null";
-                    break;
-                case Type::eString:
-                    escape_to(out, std::get<String>(m_data));
-                    break;
-                case Type::eNumber: {
-                    char buffer[24]; // Reserve enough space for typical numbers
-                    const auto [ptr, ec]  = std::to_chars(
-                        buffer,
-                        buffer + 24,
-                        std::get<Number>(m_data),
-                        std::chars_format::general,
-                        17
-                    );
-                    if(ec != std::errc{}) {
-                        std::print(out, "{:.17}", std::get<Number>(m_data));
-                    } else out.write(buffer, static_cast<std::size_t>(ptr-buffer));
-                } break;
-            }
-            if(out.fail()) return false;
-            return true;
+        /**
+         * @brief Dump the JSON data to a string with formatting.
+         * @param options The format options, see `FormatOptions`.
+         * @return A string containing the formatted JSON data.
+         * @note The result is allocated once, with the size from `serialized_size_pretty()`.
+         */
+        [[nodiscard]]
+        std::optional<String> dumpf(const FormatOptions& options) const {
+            String res;
+            res.reserve(serialized_size_pretty(options));
+            if(this->writef(res, options)) return res;
+            return std::nullopt;
         }
 
         /**
@@ -1233,6 +1842,7 @@ export namespace vct::tools::json {
          * @param depth The current depth of indentation (default is 0).
          * @param max_space The maximum number of spaces allowed for indentation in a line (default is 512).
          * @return A string containing the formatted JSON data.
+         * @note The result is allocated once, with the size from `serialized_size_pretty()`.
          */
         [[nodiscard]]
         std::optional<String> dumpf(
@@ -1240,8 +1850,7 @@ export namespace vct::tools::json {
             const std::uint16_t depth = 0,
             const std::uint32_t max_space = 512
         ) const {
-            if(String res; this->writef(res, space_num, depth, max_space)) return res;
-            return std::nullopt;
+            return dumpf(FormatOptions{ .space_num = space_num, .depth = depth, .max_space = max_space });
         }
 
         /**
@@ -1281,6 +1890,24 @@ export namespace vct::tools::json {
             return result;
         }
 
+        /**
+         * @brief Validate and skip one JSON value in the text, without creating it.
+         * @param it The iterator to the value, leading spaces are skipped. It is moved after the value on success.
+         * @param end_ptr The end iterator of the text.
+         * @param max_depth The maximum depth of nested structures allowed (default is 256).
+         * @return `ParseError::eNone` if a valid value was skipped, otherwise the same error as `parse`.
+         * @note Nothing is allocated. Strings are scanned 8 bytes at a time for quotes, escapes and control characters.
+         */
+        static ParseError skip_value(
+            std::string_view::const_iterator& it,
+            const std::string_view::const_iterator end_ptr,
+            const std::int32_t max_depth = 256
+        ) {
+            while(it != end_ptr && std::isspace(*it)) ++it;
+            if(it == end_ptr) return ParseError::eEmptyData;
+            return skip_next(it, end_ptr, max_depth-1);
+        }
+
         /**
          * @brief type conversion, copy inner value to specified type
          * @tparam T The target type to convert to
@@ -1308,6 +1935,7 @@ export namespace vct::tools::json {
          * 15. Null -> implicit convertible types (Null is not convertible to bool !!!!!)
          * 16. Object -> Try copy to `range && String->key_type && Value->mapped_type types && have default_range_value`
          * 17. Array -> Try copy to `range && Value->value_type types && have default_range_value`
+         *     (arithmetic and enum value_type: if all elements are Number, converted in one bulk pass)
          * 18. return std::nullopt;
          */
         template<typename T, typename D = Null>
@@ -1366,6 +1994,9 @@ export namespace vct::tools::json {
             if constexpr ( convertible_array<Json, T, D> ) {
                 if (type() == Type::eArray) {
                     T result{};
+                    if constexpr (std::is_arithmetic_v<typename T::value_type> || std::is_enum_v<typename T::value_type>) {
+                        if (numbers_to(std::get<Array>(m_data), result)) return result;
+                    }
                     for (auto& value : std::get<Array>(m_data)) {
                         auto val = value.template to_if<typename T::value_type>();
                         if (!val) result.emplace_back(default_range_elem);
@@ -1424,10 +2055,44 @@ export namespace vct::tools::json {
         }
 
         /**
-         * @brief type conversion, Move or Copy inner value to specified type
-         * @tparam T The target type to convert to
-         * @tparam D The mapped_type or value_type of the target type, used for range conversion, default is Null for other types(useless).
-         * @param default_range_elem if T is a range type and is not json::Array or json::Object, must be specified for safe conversion. Else, please use default value.
+         * @brief View the inner value without copying.
+         * @tparam T `std::string_view` for String, or `std::span<const Json>` for Array.
+         * @return The view, or std::nullopt if the inner type does not match.
+         * @note The view refers to the inner data, it is invalidated when this Json is modified or destroyed.
+         */
+        template<typename T>
+        requires std::is_same_v<T, std::string_view> || std::is_same_v<T, std::span<const Json>>
+        [[nodiscard]]
+        std::optional<T>  as_if() const noexcept {
+            if constexpr (std::is_same_v<T, std::string_view>) {
+                if (type() == Type::eString) return std::string_view{ std::get<String>(m_data) };
+            } else {
+                if (type() == Type::eArray) return std::span<const Json>{ std::get<Array>(m_data) };
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * @brief A lazy range that converts the array elements to `T` on iteration.
+         * @tparam T The element type, converted as `to_or<T>( default_elem )`.
+         * @param default_elem The value for elements that cannot be converted.
+         * @return A view over the inner array, empty if the inner type is not Array.
+         * @note No container is created, the view refers to the inner array like `as_if`.
+         */
+        template<typename T>
+        requires convertible<Json, T> && std::is_copy_constructible_v<T>
+        [[nodiscard]]
+        auto  as_range( T default_elem = T{} ) const {
+            return as_if<std::span<const Json>>().value_or(std::span<const Json>{}) | std::views::transform(
+                [default_elem = std::move(default_elem)](const Json& value) { return value.template to_or<T>(default_elem); }
+            );
+        }
+
+        /**
+         * @brief type conversion, Move or Copy inner value to specified type
+         * @tparam T The target type to convert to
+         * @tparam D The mapped_type or value_type of the target type, used for range conversion, default is Null for other types(useless).
+         * @param default_range_elem if T is a range type and is not json::Array or json::Object, must be specified for safe conversion. Else, please use default value.
          * @return The converted value
          * @note
          * Number is double, so conversions to integral (and enum) types will round to nearest.
@@ -1511,6 +2176,9 @@ export namespace vct::tools::json {
             if constexpr ( convertible_array<Json, T, D> ) {
                 if (type() == Type::eArray) {
                     T result{};
+                    if constexpr (std::is_arithmetic_v<typename T::value_type> || std::is_enum_v<typename T::value_type>) {
+                        if (numbers_to(std::get<Array>(m_data), result)) return result;
+                    }
                     for (auto& value : std::get<Array>(m_data)) {
                         auto val = value.template move_if<typename T::value_type>();
                         if (!val) result.emplace_back( static_cast<typename T::value_type>(default_range_elem) );
@@ -1681,7 +2349,7 @@ export namespace vct::tools::json {
          * @return True if the key exists in the JSON object, false if the JSON is not an object or the key does not exist.
          */
         [[nodiscard]]
-        bool contains(const String& key) const {
+        bool contains(const std::string_view key) const {
             if (type() == Type::eObject) return std::get<Object>(m_data).contains(key);
             return false; // Not an object
         }
@@ -1691,9 +2359,13 @@ export namespace vct::tools::json {
          * @param key The key to erase from the JSON object.
          * @return True if the key was erased, false if the JSON is not an object or the key does not exist.
          */
-        bool erase(const String& key) {
-            if (type() == Type::eObject) return std::get<Object>(m_data).erase(key);
-            return false;
+        bool erase(const std::string_view key) {
+            if (type() != Type::eObject) return false;
+            auto& object = std::get<Object>(m_data);
+            const auto it = object.find(key);
+            if (it == object.end()) return false;
+            object.erase(it);
+            return true;
         }
 
         /**
@@ -1716,7 +2388,7 @@ export namespace vct::tools::json {
          * @return True if the key-value pair was inserted, false if the JSON is not an object.
          */
         template<typename  K, typename V>
-        requires std::convertible_to<K, String> && std::convertible_to<V, Json>
+        requires std::constructible_from<String, K> && std::convertible_to<V, Json>
         bool insert(K&& key, V&& value) {
             if (type() == Type::eObject) {
                 std::get<Object>(m_data).emplace(static_cast<String>(std::forward<K>(key)), static_cast<Json>(std::forward<V>(value)));
@@ -1768,6 +2440,2716 @@ export namespace vct::tools::json {
             return false;
         }
 
+        /**
+         * @brief A JSON Pointer (RFC 6901), parsed once and evaluated many times.
+         * @details
+         * The reference tokens are split and unescaped (`~1` to `/`, `~0` to `~`) when parsing,
+         * tokens that are valid array indices are converted to numbers at the same time.
+         * Evaluation is then only a map lookup or an index per token, no temporary String is created.
+         * @code
+         * const auto price = Json::Pointer::parse("/payload/items/0/price").value();
+         * double value = json.at(price).num();
+         * @endcode
+         */
+        class Pointer {
+        public:
+            /**
+             * @brief An unescaped reference token.
+             */
+            struct Token {
+                String key;                                         ///< The unescaped token
+                std::size_t index{ std::numeric_limits<std::size_t>::max() };  ///< Array index, max if `key` is not an index
+            };
+
+        private:
+            std::vector<Token, AllocatorType<Token>> m_tokens;
+
+            // array index of a token, leading zeros are not allowed
+            static std::size_t index_of(const std::string_view key) noexcept {
+                std::size_t index;
+                if (key.empty() || (key.size() > 1 && key.front() == '0')) return Token{}.index;
+                if (const auto [ptr, ec] = std::from_chars(key.data(), key.data() + key.size(), index);
+                    ec != std::errc{} || ptr != key.data() + key.size()
+                ) return Token{}.index;
+                return index;
+            }
+
+        public:
+            /**
+             * @brief The empty pointer, which refers to the whole document.
+             */
+            Pointer() = default;
+
+            /**
+             * @brief Parse a JSON Pointer string.
+             * @return std::nullopt if the text is not empty and does not start with `/`, or contains a `~` not followed by `0` or `1`.
+             */
+            [[nodiscard]]
+            static std::optional<Pointer> parse(const std::string_view text) {
+                if (text.empty()) return Pointer{};
+                if (text.front() != '/') return std::nullopt;
+                Pointer pointer;
+                std::size_t begin = 1;
+                while (true) {
+                    const std::size_t end = std::min(text.find('/', begin), text.size());
+                    Token token;
+                    token.key.reserve(end - begin);
+                    for (std::size_t i = begin; i < end; ++i) {
+                        if (text[i] != '~') {
+                            token.key.push_back(text[i]);
+                        } else if (++i < end && (text[i] == '0' || text[i] == '1')) {
+                            token.key.push_back(text[i] == '0' ? '~' : '/');
+                        } else return std::nullopt;
+                    }
+                    token.index = index_of(token.key);
+                    pointer.m_tokens.push_back(std::move(token));
+                    if (end == text.size()) break;
+                    begin = end + 1;
+                }
+                return pointer;
+            }
+
+            /**
+             * @brief The reference tokens.
+             */
+            [[nodiscard]]
+            std::span<const Token> tokens() const noexcept { return m_tokens; }
+
+            /**
+             * @brief Check if this is the empty pointer (the whole document).
+             */
+            [[nodiscard]]
+            bool empty() const noexcept { return m_tokens.empty(); }
+
+            /**
+             * @brief The pointer without its last token, the empty pointer stays empty.
+             */
+            [[nodiscard]]
+            Pointer parent() const {
+                Pointer pointer;
+                if (!m_tokens.empty()) pointer.m_tokens.assign(m_tokens.begin(), m_tokens.end() - 1);
+                return pointer;
+            }
+
+            /**
+             * @brief Append a token, as an unescaped key or an array index.
+             */
+            Pointer& push_back(const std::string_view key) {
+                m_tokens.push_back(Token{ String{ key }, index_of(key) });
+                return *this;
+            }
+            Pointer& push_back(const std::size_t index) {
+                m_tokens.push_back(Token{ String{ std::to_string(index) }, index });
+                return *this;
+            }
+
+            /**
+             * @brief Remove the last token, the empty pointer stays empty.
+             */
+            Pointer& pop_back() noexcept {
+                if (!m_tokens.empty()) m_tokens.pop_back();
+                return *this;
+            }
+
+            /**
+             * @brief Get the escaped string form.
+             */
+            [[nodiscard]]
+            String to_string() const {
+                String out;
+                for (const auto& token : m_tokens) {
+                    out.push_back('/');
+                    for (const char c : token.key) {
+                        if (c == '~') out.append("~0");
+                        else if (c == '/') out.append("~1");
+                        else out.push_back(c);
+                    }
+                }
+                return out;
+            }
+
+            [[nodiscard]]
+            bool operator==(const Pointer& other) const noexcept {
+                return std::ranges::equal(m_tokens, other.m_tokens, {}, &Token::key, &Token::key);
+            }
+        };
+
+        /**
+         * @brief Find the value that a JSON Pointer refers to.
+         * @return Pointer to the value, nullptr if any token does not exist.
+         * @note Array elements are only matched by valid indices, `-` never refers to an element.
+         */
+        [[nodiscard]]
+        Json* find(const Pointer& pointer) noexcept {
+            return const_cast<Json*>(std::as_const(*this).find_tokens(pointer.tokens()));
+        }
+        [[nodiscard]]
+        const Json* find(const Pointer& pointer) const noexcept { return find_tokens(pointer.tokens()); }
+
+    private:
+        const Json* find_tokens(const std::span<const typename Pointer::Token> tokens) const noexcept {
+            const Json* node = this;
+            for (const auto& token : tokens) {
+                if (node->is_obj()) {
+                    node = node->find(token.key);
+                    if (node == nullptr) return nullptr;
+                } else if (node->is_arr()) {
+                    if (token.index >= node->arr().size()) return nullptr;
+                    node = &node->arr()[token.index];
+                } else return nullptr;
+            }
+            return node;
+        }
+
+    public:
+        /**
+         * @brief Get the value that a JSON Pointer refers to.
+         * @throw std::out_of_range if any token does not exist.
+         */
+        [[nodiscard]]
+        Json& at(const Pointer& pointer) {
+            if (const auto node = find(pointer)) return *node;
+            throw std::out_of_range("Json::at: pointer not found");
+        }
+        [[nodiscard]]
+        const Json& at(const Pointer& pointer) const {
+            if (const auto node = find(pointer)) return *node;
+            throw std::out_of_range("Json::at: pointer not found");
+        }
+
+        /**
+         * @brief Set or replace the value that a JSON Pointer refers to.
+         * @param pointer The target, its parent must exist.
+         * @param value The new value.
+         * @return True if the value was set. False if the parent does not exist or is not a container,
+         * or the parent is an array and the last token is neither an index within `[0, size]` nor `-`.
+         * @details
+         * Object members are inserted or replaced. An existing array element is replaced,
+         * index `size` or `-` appends. The empty pointer replaces the whole document.
+         * Unlike the JSON Patch `add` operation, nothing is inserted before an existing element,
+         * use `apply_patch` for that.
+         */
+        template<typename V>
+        requires std::convertible_to<V, Json>
+        bool set(const Pointer& pointer, V&& value) {
+            if (pointer.empty()) {
+                *this = static_cast<Json>(std::forward<V>(value));
+                return true;
+            }
+            const auto parent = const_cast<Json*>(find_tokens(pointer.tokens().first(pointer.tokens().size() - 1)));
+            if (parent == nullptr) return false;
+            const auto& token = pointer.tokens().back();
+            if (parent->is_obj()) {
+                parent->obj().insert_or_assign(token.key, static_cast<Json>(std::forward<V>(value)));
+                return true;
+            }
+            if (parent->is_arr()) {
+                auto& array = parent->arr();
+                if (token.index < array.size()) array[token.index] = static_cast<Json>(std::forward<V>(value));
+                else if (token.index == array.size() || token.key == "-") array.emplace_back(static_cast<Json>(std::forward<V>(value)));
+                else return false;
+                return true;
+            }
+            return false;
+        }
+
+        /**
+         * @brief Create a JSON Patch (RFC 6902) that turns `source` into `target`.
+         * @return An array of `add`, `remove` and `replace` operations, empty if the documents are equal.
+         * @details
+         * Objects are compared member by member and arrays element by element, so a small edit produces a small patch.
+         * Elements inserted into or removed from the middle of an array show up as changes of the following elements.
+         * A subtree compared with itself (the same object) is skipped without being visited.
+         */
+        [[nodiscard]]
+        static Json diff(const Json& source, const Json& target) {
+            Json patch{ Array{} };
+            Pointer path;
+            diff_to(patch.arr(), path, source, target);
+            return patch;
+        }
+
+    private:
+        static Json patch_op(const std::string_view op, const Pointer& path, const Json* const value = nullptr) {
+            Json result{ Object{} };
+            auto& object = result.obj();
+            object.emplace("op", String{ op });
+            object.emplace("path", path.to_string());
+            if (value != nullptr) object.emplace("value", *value);
+            return result;
+        }
+
+        static void diff_to(Array& ops, Pointer& path, const Json& source, const Json& target) {
+            if (&source == &target) return;
+            if (source.is_obj() && target.is_obj()) {
+                const auto& from = source.obj();
+                const auto& to = target.obj();
+                for (const auto& [key, value] : from) {
+                    path.push_back(key);
+                    if (const auto it = to.find(key); it != to.end()) diff_to(ops, path, value, it->second);
+                    else ops.push_back(patch_op("remove", path));
+                    path.pop_back();
+                }
+                for (const auto& [key, value] : to) {
+                    if (from.contains(key)) continue;
+                    path.push_back(key);
+                    ops.push_back(patch_op("add", path, &value));
+                    path.pop_back();
+                }
+            } else if (source.is_arr() && target.is_arr()) {
+                const auto& from = source.arr();
+                const auto& to = target.arr();
+                const std::size_t common = std::min(from.size(), to.size());
+                for (std::size_t i = 0; i < common; ++i) {
+                    path.push_back(i);
+                    diff_to(ops, path, from[i], to[i]);
+                    path.pop_back();
+                }
+                for (std::size_t i = common; i < to.size(); ++i) {
+                    path.push_back(i);
+                    ops.push_back(patch_op("add", path, &to[i]));
+                    path.pop_back();
+                }
+                // from the back, so the indices of the remaining elements do not change
+                for (std::size_t i = from.size(); i-- > common; ) {
+                    path.push_back(i);
+                    ops.push_back(patch_op("remove", path));
+                    path.pop_back();
+                }
+            } else if (source != target) {
+                ops.push_back(patch_op("replace", path, &target));
+            }
+        }
+
+    public:
+        /**
+         * @brief Apply a JSON Patch (RFC 6902) to this document in place.
+         * @param patch An array of operations: `add`, `remove`, `replace`, `move`, `copy` and `test`.
+         * @return True if every operation succeeded. Otherwise false, and the document is restored to its state before the call.
+         * @details
+         * Values are inserted, moved and removed in place, only the values in the patch (and the source of `copy`) are copied.
+         * Each operation keeps what it replaced or removed, so a failed patch is undone step by step
+         * without a copy of the whole document.
+         */
+        bool apply_patch(const Json& patch) {
+            if (!patch.is_arr()) return false;
+
+            // insert or set `value` at `path`, `value` is only moved from on success
+            const auto add_at = [this](const Pointer& path, Json& value, std::optional<Json>& replaced, Pointer& at) {
+                at = path;
+                if (path.empty()) {
+                    replaced = std::exchange(*this, std::move(value));
+                    return true;
+                }
+                const auto parent = const_cast<Json*>(find_tokens(path.tokens().first(path.tokens().size() - 1)));
+                if (parent == nullptr) return false;
+                const auto& token = path.tokens().back();
+                if (parent->is_obj()) {
+                    auto& object = parent->obj();
+                    if (const auto it = object.find(token.key); it != object.end()) replaced = std::exchange(it->second, std::move(value));
+                    else object.emplace(token.key, std::move(value));
+                    return true;
+                }
+                if (!parent->is_arr()) return false;
+                auto& array = parent->arr();
+                const std::size_t index = token.key == "-" ? array.size() : token.index;
+                if (index > array.size()) return false;
+                array.insert(array.begin() + static_cast<std::ptrdiff_t>(index), std::move(value));
+                at.pop_back().push_back(index);
+                return true;
+            };
+            const auto remove_at = [this](const Pointer& path) -> std::optional<Json> {
+                if (path.empty()) return std::nullopt;
+                const auto parent = const_cast<Json*>(find_tokens(path.tokens().first(path.tokens().size() - 1)));
+                if (parent == nullptr) return std::nullopt;
+                const auto& token = path.tokens().back();
+                if (parent->is_obj()) {
+                    auto& object = parent->obj();
+                    const auto it = object.find(token.key);
+                    if (it == object.end()) return std::nullopt;
+                    Json value{ std::move(it->second) };
+                    object.erase(it);
+                    return value;
+                }
+                if (!parent->is_arr() || token.index >= parent->arr().size()) return std::nullopt;
+                auto& array = parent->arr();
+                Json value{ std::move(array[token.index]) };
+                array.erase(array.begin() + static_cast<std::ptrdiff_t>(token.index));
+                return value;
+            };
+            const auto replace_at = [this](const Pointer& path, Json& value) -> std::optional<Json> {
+                const auto node = find(path);
+                if (node == nullptr) return std::nullopt;
+                return std::exchange(*node, std::move(value));
+            };
+
+            // the inverse of each applied operation, `path` is where the value is now
+            enum class Step : std::uint8_t { eAdded, eRemoved, eReplaced, eMoved };
+            struct Undo {
+                Step step;
+                Pointer path;
+                Pointer from;               ///< eMoved
+                std::optional<Json> value;  ///< the replaced or removed value
+            };
+            std::vector<Undo> undo;
+            const auto rollback = [&] {
+                for (auto& [step, path, from, value] : std::views::reverse(undo)) {
+                    std::optional<Json> replaced;
+                    Pointer at;
+                    switch (step) {
+                        case Step::eAdded:
+                            if (value) replace_at(path, *value);
+                            else remove_at(path);
+                            break;
+                        case Step::eRemoved: add_at(path, *value, replaced, at); break;
+                        case Step::eReplaced: replace_at(path, *value); break;
+                        case Step::eMoved: {
+                            auto moved = value ? replace_at(path, *value) : remove_at(path);
+                            add_at(from, *moved, replaced, at);
+                        } break;
+                    }
+                }
+                return false;
+            };
+
+            for (const Json& op : patch.arr()) {
+                const Json* const name = op.find("op");
+                const Json* const target = op.find("path");
+                if (name == nullptr || !name->is_str() || target == nullptr || !target->is_str()) return rollback();
+                auto path = Pointer::parse(target->str());
+                if (!path) return rollback();
+                const std::string_view kind = name->str();
+                const Json* const value = op.find("value");
+
+                if (kind == "add" || kind == "replace" || kind == "test") {
+                    if (value == nullptr) return rollback();
+                    if (kind == "test") {
+                        if (const auto node = find(*path); node == nullptr || *node != *value) return rollback();
+                        continue;
+                    }
+                    Json copy{ *value };
+                    if (kind == "replace") {
+                        auto old = replace_at(*path, copy);
+                        if (!old) return rollback();
+                        undo.push_back(Undo{ Step::eReplaced, std::move(*path), {}, std::move(old) });
+                        continue;
+                    }
+                    std::optional<Json> replaced;
+                    Pointer at;
+                    if (!add_at(*path, copy, replaced, at)) return rollback();
+                    undo.push_back(Undo{ Step::eAdded, std::move(at), {}, std::move(replaced) });
+                } else if (kind == "remove") {
+                    auto old = remove_at(*path);
+                    if (!old) return rollback();
+                    undo.push_back(Undo{ Step::eRemoved, std::move(*path), {}, std::move(old) });
+                } else if (kind == "move" || kind == "copy") {
+                    const Json* const source = op.find("from");
+                    if (source == nullptr || !source->is_str()) return rollback();
+                    auto from = Pointer::parse(source->str());
+                    if (!from) return rollback();
+                    std::optional<Json> replaced;
+                    Pointer at;
+                    if (kind == "copy") {
+                        const auto node = find(*from);
+                        if (node == nullptr) return rollback();
+                        Json copy{ *node };
+                        if (!add_at(*path, copy, replaced, at)) return rollback();
+                        undo.push_back(Undo{ Step::eAdded, std::move(at), {}, std::move(replaced) });
+                        continue;
+                    }
+                    if (*from == *path) {
+                        if (find(*from) == nullptr) return rollback();
+                        continue;
+                    }
+                    // a value cannot be moved into one of its own children
+                    const auto from_tokens = from->tokens();
+                    const auto path_tokens = path->tokens();
+                    if (from_tokens.size() < path_tokens.size() && std::ranges::equal(
+                        from_tokens, path_tokens.first(from_tokens.size()), {}, &Pointer::Token::key, &Pointer::Token::key
+                    )) return rollback();
+                    auto moved = remove_at(*from);
+                    if (!moved) return rollback();
+                    if (!add_at(*path, *moved, replaced, at)) {
+                        add_at(*from, *moved, replaced, at);
+                        return rollback();
+                    }
+                    undo.push_back(Undo{ Step::eMoved, std::move(at), std::move(*from), std::move(replaced) });
+                } else return rollback();
+            }
+            return true;
+        }
+
+        /**
+         * @brief A JSONPath query (RFC 9535), compiled once into a plan and evaluated many times.
+         * @details
+         * Supports child and descendant (`..`) segments, name, wildcard, index, slice and filter selectors.
+         * Filters support `||`, `&&`, `!`, parentheses, existence tests and comparisons between literals and
+         * singular queries (`@` relative to the current node, `$` to the root).
+         * Function extensions (`length()`, `match()`, ...) are not supported, such queries fail to parse.
+         * The result is a list of pointers into the document, in document order, nothing is copied.
+         * @code
+         * const auto path = Json::Path::parse("$.events[?@.level >= 3].id").value();
+         * for (const Json* id : path.query(document)) { ... }
+         * @endcode
+         */
+        class Path {
+            struct Selector {
+                enum class Kind : std::uint8_t { eName, eWildcard, eIndex, eSlice, eFilter };
+                Kind kind{};
+                String name;                ///< eName
+                std::int64_t start{};       ///< eIndex, eSlice
+                std::int64_t end{};         ///< eSlice
+                std::int64_t step{ 1 };     ///< eSlice
+                bool has_start{};           ///< eSlice
+                bool has_end{};             ///< eSlice
+                std::size_t filter{};       ///< eFilter, index of the root expression
+            };
+            struct Segment {
+                bool descendant{};
+                std::vector<Selector> selectors;
+            };
+            struct Operand {
+                bool is_query{};
+                std::size_t index{};        ///< Index of the query or the literal
+            };
+            struct Expr {
+                enum class Kind : std::uint8_t { eOr, eAnd, eNot, eExists, eCompare };
+                enum class Op : std::uint8_t { eEq, eNe, eLt, eLe, eGt, eGe };
+                Kind kind{};
+                Op op{};
+                std::size_t lhs{};          ///< eOr, eAnd, eNot: sub-expression, eExists: query
+                std::size_t rhs{};          ///< eOr, eAnd: sub-expression
+                Operand left;               ///< eCompare
+                Operand right;              ///< eCompare
+            };
+            static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+            static constexpr std::int64_t max_int = (std::int64_t{1} << 53) - 1;
+
+            std::vector<Segment> m_segments;
+            std::vector<Expr> m_exprs;
+            std::vector<Path> m_queries;    ///< Queries inside filters
+            Array m_literals;               ///< Literals inside filters
+            bool m_relative{};              ///< Starts at `@` instead of `$`
+
+            // ---------------------------------------------------------------- parsing
+
+            static void skip_blank(const std::string_view text, std::size_t& pos) noexcept {
+                while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n' || text[pos] == '\r')) ++pos;
+            }
+
+            // I-JSON integer, `pos` is unchanged on failure
+            static bool parse_int(const std::string_view text, std::size_t& pos, std::int64_t& out) noexcept {
+                std::size_t end = pos;
+                if (end < text.size() && text[end] == '-') ++end;
+                if (end >= text.size() || !std::isdigit(static_cast<unsigned char>(text[end]))) return false;
+                if (text[end] == '0' && (end != pos || (end + 1 < text.size() && std::isdigit(static_cast<unsigned char>(text[end + 1]))))) return false;
+                while (end < text.size() && std::isdigit(static_cast<unsigned char>(text[end]))) ++end;
+                const auto [ptr, ec] = std::from_chars(text.data() + pos, text.data() + end, out);
+                if (ec != std::errc{} || out > max_int || out < -max_int) return false;
+                pos = end;
+                return true;
+            }
+
+            static bool parse_string(const std::string_view text, std::size_t& pos, String& out) {
+                const char quote = text[pos++];
+                while (pos < text.size() && text[pos] != quote) {
+                    const char c = text[pos];
+                    if (static_cast<unsigned char>(c) < 0x20) return false;
+                    if (c != '\\') {
+                        out.push_back(c);
+                        ++pos;
+                        continue;
+                    }
+                    if (++pos >= text.size()) return false;
+                    switch (text[pos]) {
+                        case 'b': out.push_back('\b'); break;
+                        case 'f': out.push_back('\f'); break;
+                        case 'n': out.push_back('\n'); break;
+                        case 'r': out.push_back('\r'); break;
+                        case 't': out.push_back('\t'); break;
+                        case '/': out.push_back('/'); break;
+                        case '\\': out.push_back('\\'); break;
+                        case '\'': case '\"': {
+                            if (text[pos] != quote) return false;
+                            out.push_back(quote);
+                        } break;
+                        case 'u': {
+                            auto it = text.begin() + static_cast<std::ptrdiff_t>(pos);
+                            if (!unescape_unicode_next(out, it, text.end())) return false;
+                            pos = static_cast<std::size_t>(it - text.begin());
+                        } break;
+                        default: return false;
+                    }
+                    ++pos;
+                }
+                if (pos >= text.size()) return false;
+                ++pos;
+                return true;
+            }
+
+            static bool parse_name(const std::string_view text, std::size_t& pos, String& out) {
+                const auto first = [](const char c) {
+                    return std::isalpha(static_cast<unsigned char>(c)) || c == '_' || static_cast<unsigned char>(c) >= 0x80;
+                };
+                const std::size_t begin = pos;
+                if (pos >= text.size() || !first(text[pos])) return false;
+                while (pos < text.size() && (first(text[pos]) || std::isdigit(static_cast<unsigned char>(text[pos])))) ++pos;
+                out.assign(text.substr(begin, pos - begin));
+                return true;
+            }
+
+            bool parse_selector(const std::string_view text, std::size_t& pos, Selector& selector) {
+                if (pos >= text.size()) return false;
+                switch (text[pos]) {
+                    case '\'': case '\"':
+                        selector.kind = Selector::Kind::eName;
+                        return parse_string(text, pos, selector.name);
+                    case '*':
+                        selector.kind = Selector::Kind::eWildcard;
+                        ++pos;
+                        return true;
+                    case '?':
+                        selector.kind = Selector::Kind::eFilter;
+                        ++pos;
+                        selector.filter = parse_or(text, pos);
+                        return selector.filter != npos;
+                    default: break;
+                }
+                selector.has_start = parse_int(text, pos, selector.start);
+                skip_blank(text, pos);
+                if (pos >= text.size() || text[pos] != ':') {
+                    selector.kind = Selector::Kind::eIndex;
+                    return selector.has_start;
+                }
+                selector.kind = Selector::Kind::eSlice;
+                ++pos;
+                skip_blank(text, pos);
+                selector.has_end = parse_int(text, pos, selector.end);
+                skip_blank(text, pos);
+                if (pos < text.size() && text[pos] == ':') {
+                    ++pos;
+                    skip_blank(text, pos);
+                    if (!parse_int(text, pos, selector.step)) selector.step = 1;
+                }
+                return true;
+            }
+
+            bool parse_segments(const std::string_view text, std::size_t& pos) {
+                while (true) {
+                    const std::size_t mark = pos;
+                    skip_blank(text, pos);
+                    if (pos >= text.size()) {
+                        pos = mark;
+                        return true;
+                    }
+                    Segment segment;
+                    if (text.substr(pos, 2) == "..") {
+                        segment.descendant = true;
+                        pos += 2;
+                        if (pos < text.size() && text[pos] != '[') {
+                            auto& selector = segment.selectors.emplace_back();
+                            if (text[pos] == '*') {
+                                selector.kind = Selector::Kind::eWildcard;
+                                ++pos;
+                            } else if (!parse_name(text, pos, selector.name)) return false;
+                            m_segments.push_back(std::move(segment));
+                            continue;
+                        }
+                    } else if (text[pos] == '.') {
+                        ++pos;
+                        auto& selector = segment.selectors.emplace_back();
+                        if (pos < text.size() && text[pos] == '*') {
+                            selector.kind = Selector::Kind::eWildcard;
+                            ++pos;
+                        } else if (!parse_name(text, pos, selector.name)) return false;
+                        m_segments.push_back(std::move(segment));
+                        continue;
+                    } else if (text[pos] != '[') {
+                        pos = mark;
+                        return true;
+                    }
+                    if (pos >= text.size()) return false;
+                    // bracketed selection
+                    ++pos;
+                    while (true) {
+                        skip_blank(text, pos);
+                        if (!parse_selector(text, pos, segment.selectors.emplace_back())) return false;
+                        skip_blank(text, pos);
+                        if (pos >= text.size()) return false;
+                        if (text[pos] == ']') break;
+                        if (text[pos] != ',') return false;
+                        ++pos;
+                    }
+                    ++pos;
+                    m_segments.push_back(std::move(segment));
+                }
+            }
+
+            std::size_t push_expr(const Expr& expr) {
+                m_exprs.push_back(expr);
+                return m_exprs.size() - 1;
+            }
+
+            std::size_t parse_or(const std::string_view text, std::size_t& pos) {
+                std::size_t lhs = parse_and(text, pos);
+                while (lhs != npos) {
+                    skip_blank(text, pos);
+                    if (text.substr(pos, 2) != "||") break;
+                    pos += 2;
+                    const std::size_t rhs = parse_and(text, pos);
+                    if (rhs == npos) return npos;
+                    lhs = push_expr(Expr{ .kind = Expr::Kind::eOr, .lhs = lhs, .rhs = rhs });
+                }
+                return lhs;
+            }
+
+            std::size_t parse_and(const std::string_view text, std::size_t& pos) {
+                std::size_t lhs = parse_basic(text, pos);
+                while (lhs != npos) {
+                    skip_blank(text, pos);
+                    if (text.substr(pos, 2) != "&&") break;
+                    pos += 2;
+                    const std::size_t rhs = parse_basic(text, pos);
+                    if (rhs == npos) return npos;
+                    lhs = push_expr(Expr{ .kind = Expr::Kind::eAnd, .lhs = lhs, .rhs = rhs });
+                }
+                return lhs;
+            }
+
+            std::size_t parse_paren(const std::string_view text, std::size_t& pos) {
+                ++pos;
+                const std::size_t expr = parse_or(text, pos);
+                skip_blank(text, pos);
+                if (expr == npos || pos >= text.size() || text[pos] != ')') return npos;
+                ++pos;
+                return expr;
+            }
+
+            std::size_t parse_basic(const std::string_view text, std::size_t& pos) {
+                skip_blank(text, pos);
+                if (pos >= text.size()) return npos;
+                if (text[pos] == '!') {
+                    ++pos;
+                    skip_blank(text, pos);
+                    std::size_t expr = npos;
+                    if (pos < text.size() && text[pos] == '(') {
+                        expr = parse_paren(text, pos);
+                    } else if (pos < text.size() && (text[pos] == '@' || text[pos] == '$')) {
+                        Operand operand;
+                        if (!parse_comparable(text, pos, operand)) return npos;
+                        expr = push_expr(Expr{ .kind = Expr::Kind::eExists, .lhs = operand.index });
+                    }
+                    if (expr == npos) return npos;
+                    return push_expr(Expr{ .kind = Expr::Kind::eNot, .lhs = expr });
+                }
+                if (text[pos] == '(') return parse_paren(text, pos);
+
+                Operand left;
+                if (!parse_comparable(text, pos, left)) return npos;
+                const std::size_t mark = pos;
+                skip_blank(text, pos);
+                typename Expr::Op op;
+                const std::string_view rest = text.substr(pos);
+                if (rest.starts_with("==")) op = Expr::Op::eEq;
+                else if (rest.starts_with("!=")) op = Expr::Op::eNe;
+                else if (rest.starts_with("<=")) op = Expr::Op::eLe;
+                else if (rest.starts_with(">=")) op = Expr::Op::eGe;
+                else if (rest.starts_with("<")) op = Expr::Op::eLt;
+                else if (rest.starts_with(">")) op = Expr::Op::eGt;
+                else {
+                    // existence test, only queries
+                    pos = mark;
+                    if (!left.is_query) return npos;
+                    return push_expr(Expr{ .kind = Expr::Kind::eExists, .lhs = left.index });
+                }
+                pos += op == Expr::Op::eLt || op == Expr::Op::eGt ? 1 : 2;
+                skip_blank(text, pos);
+                Operand right;
+                if (!parse_comparable(text, pos, right)) return npos;
+                if ((left.is_query && !m_queries[left.index].is_singular()) ||
+                    (right.is_query && !m_queries[right.index].is_singular())
+                ) return npos;
+                return push_expr(Expr{ .kind = Expr::Kind::eCompare, .op = op, .left = left, .right = right });
+            }
+
+            bool parse_comparable(const std::string_view text, std::size_t& pos, Operand& operand) {
+                if (pos >= text.size()) return false;
+                const char c = text[pos];
+                if (c == '@' || c == '$') {
+                    Path query;
+                    query.m_relative = c == '@';
+                    ++pos;
+                    if (!query.parse_segments(text, pos)) return false;
+                    m_queries.push_back(std::move(query));
+                    operand = Operand{ true, m_queries.size() - 1 };
+                    return true;
+                }
+                const auto literal = [&](const std::string_view word, Json value) {
+                    if (!text.substr(pos).starts_with(word)) return false;
+                    pos += word.size();
+                    m_literals.push_back(std::move(value));
+                    return true;
+                };
+                if (c == '\'' || c == '\"') {
+                    String str;
+                    if (!parse_string(text, pos, str)) return false;
+                    m_literals.emplace_back(std::move(str));
+                } else if (c == 't') {
+                    if (!literal("true", true)) return false;
+                } else if (c == 'f') {
+                    if (!literal("false", false)) return false;
+                } else if (c == 'n') {
+                    if (!literal("null", nullptr)) return false;
+                } else if (c == '-' || std::isdigit(static_cast<unsigned char>(c))) {
+                    auto it = text.begin() + static_cast<std::ptrdiff_t>(pos);
+                    const auto number = number_next(it, text.end());
+                    if (!number) return false;
+                    pos = static_cast<std::size_t>(it - text.begin());
+                    m_literals.emplace_back(*number);
+                } else return false;
+                operand = Operand{ false, m_literals.size() - 1 };
+                return true;
+            }
+
+            // ---------------------------------------------------------------- evaluation
+
+            static void descend(const Json& node, const auto& visit) {
+                visit(node);
+                if (node.is_arr()) for (const auto& val : node.arr()) descend(val, visit);
+                else if (node.is_obj()) for (const auto& [key, val] : node.obj()) descend(val, visit);
+            }
+
+            void select(const Selector& selector, const Json& node, const Json& root, std::vector<const Json*>& out) const {
+                switch (selector.kind) {
+                    case Selector::Kind::eName: {
+                        if (const Json* value = node.find(selector.name)) out.push_back(value);
+                    } break;
+                    case Selector::Kind::eWildcard: {
+                        if (node.is_arr()) for (const auto& val : node.arr()) out.push_back(&val);
+                        else if (node.is_obj()) for (const auto& [key, val] : node.obj()) out.push_back(&val);
+                    } break;
+                    case Selector::Kind::eIndex: {
+                        if (!node.is_arr()) break;
+                        const auto size = static_cast<std::int64_t>(node.arr().size());
+                        const std::int64_t index = selector.start < 0 ? size + selector.start : selector.start;
+                        if (index >= 0 && index < size) out.push_back(&node.arr()[static_cast<std::size_t>(index)]);
+                    } break;
+                    case Selector::Kind::eSlice: {
+                        if (!node.is_arr() || selector.step == 0) break;
+                        const auto size = static_cast<std::int64_t>(node.arr().size());
+                        const auto normalize = [size](const std::int64_t i) { return i < 0 ? size + i : i; };
+                        const std::int64_t step = selector.step;
+                        if (step > 0) {
+                            const std::int64_t lower = std::clamp<std::int64_t>(selector.has_start ? normalize(selector.start) : 0, 0, size);
+                            const std::int64_t upper = std::clamp<std::int64_t>(selector.has_end ? normalize(selector.end) : size, 0, size);
+                            for (std::int64_t i = lower; i < upper; i += step) out.push_back(&node.arr()[static_cast<std::size_t>(i)]);
+                        } else {
+                            const std::int64_t upper = std::clamp<std::int64_t>(selector.has_start ? normalize(selector.start) : size - 1, -1, size - 1);
+                            const std::int64_t lower = std::clamp<std::int64_t>(selector.has_end ? normalize(selector.end) : -size - 1, -1, size - 1);
+                            for (std::int64_t i = upper; lower < i; i += step) out.push_back(&node.arr()[static_cast<std::size_t>(i)]);
+                        }
+                    } break;
+                    case Selector::Kind::eFilter: {
+                        if (node.is_arr()) {
+                            for (const auto& val : node.arr()) if (test(selector.filter, val, root)) out.push_back(&val);
+                        } else if (node.is_obj()) {
+                            for (const auto& [key, val] : node.obj()) if (test(selector.filter, val, root)) out.push_back(&val);
+                        }
+                    } break;
+                }
+            }
+
+            void evaluate(const Json& current, const Json& root, std::vector<const Json*>& out) const {
+                std::vector<const Json*> nodes{ m_relative ? &current : &root };
+                std::vector<const Json*> next;
+                for (const auto& segment : m_segments) {
+                    next.clear();
+                    for (const Json* node : nodes) {
+                        if (segment.descendant) {
+                            descend(*node, [&](const Json& child) {
+                                for (const auto& selector : segment.selectors) select(selector, child, root, next);
+                            });
+                        } else {
+                            for (const auto& selector : segment.selectors) select(selector, *node, root, next);
+                        }
+                    }
+                    std::swap(nodes, next);
+                }
+                out.insert(out.end(), nodes.begin(), nodes.end());
+            }
+
+            // nullptr means Nothing (an empty singular query)
+            const Json* resolve(const Operand& operand, const Json& current, const Json& root) const {
+                if (!operand.is_query) return &m_literals[operand.index];
+                std::vector<const Json*> nodes;
+                m_queries[operand.index].evaluate(current, root, nodes);
+                return nodes.size() == 1 ? nodes.front() : nullptr;
+            }
+
+            static bool less(const Json* a, const Json* b) noexcept {
+                if (a == nullptr || b == nullptr) return false;
+                if (a->is_num() && b->is_num()) return a->num() < b->num();
+                if (a->is_str() && b->is_str()) return a->str() < b->str();
+                return false;
+            }
+
+            static bool equal(const Json* a, const Json* b) noexcept {
+                if (a == nullptr || b == nullptr) return a == b;
+                return *a == *b;
+            }
+
+            bool test(const std::size_t index, const Json& current, const Json& root) const {
+                const Expr& expr = m_exprs[index];
+                switch (expr.kind) {
+                    case Expr::Kind::eOr: return test(expr.lhs, current, root) || test(expr.rhs, current, root);
+                    case Expr::Kind::eAnd: return test(expr.lhs, current, root) && test(expr.rhs, current, root);
+                    case Expr::Kind::eNot: return !test(expr.lhs, current, root);
+                    case Expr::Kind::eExists: {
+                        std::vector<const Json*> nodes;
+                        m_queries[expr.lhs].evaluate(current, root, nodes);
+                        return !nodes.empty();
+                    }
+                    case Expr::Kind::eCompare: {
+                        const Json* a = resolve(expr.left, current, root);
+                        const Json* b = resolve(expr.right, current, root);
+                        switch (expr.op) {
+                            case Expr::Op::eEq: return equal(a, b);
+                            case Expr::Op::eNe: return !equal(a, b);
+                            case Expr::Op::eLt: return less(a, b);
+                            case Expr::Op::eLe: return less(a, b) || equal(a, b);
+                            case Expr::Op::eGt: return less(b, a);
+                            case Expr::Op::eGe: return less(b, a) || equal(a, b);
+                        }
+                    }
+                }
+                return false;
+            }
+
+        public:
+            /**
+             * @brief Compile a JSONPath query.
+             * @return std::nullopt if the text is not a valid query, or uses function extensions.
+             */
+            [[nodiscard]]
+            static std::optional<Path> parse(const std::string_view text) {
+                if (text.empty() || text.front() != '$') return std::nullopt;
+                Path path;
+                std::size_t pos = 1;
+                if (!path.parse_segments(text, pos) || pos != text.size()) return std::nullopt;
+                return path;
+            }
+
+            /**
+             * @brief Check if the query selects at most one node (only name and index selectors, no descendants).
+             */
+            [[nodiscard]]
+            bool is_singular() const noexcept {
+                return std::ranges::all_of(m_segments, [](const Segment& segment) {
+                    return !segment.descendant && segment.selectors.size() == 1 && (
+                        segment.selectors.front().kind == Selector::Kind::eName ||
+                        segment.selectors.front().kind == Selector::Kind::eIndex
+                    );
+                });
+            }
+
+            /**
+             * @brief Evaluate the query.
+             * @return Pointers to the selected nodes in document order, valid until the document is modified.
+             */
+            [[nodiscard]]
+            std::vector<const Json*> query(const Json& json) const {
+                std::vector<const Json*> nodes;
+                evaluate(json, json, nodes);
+                return nodes;
+            }
+            [[nodiscard]]
+            std::vector<Json*> query(Json& json) const {
+                std::vector<Json*> nodes;
+                for (const Json* node : query(std::as_const(json))) nodes.push_back(const_cast<Json*>(node));
+                return nodes;
+            }
+        };
+
+        class Reader;
+
+        /**
+         * @brief A JSON value kept as its unparsed text, for passing opaque sub-documents through.
+         * @details
+         * The text is validated once when it is created, and written as-is by `Writer::value`.
+         * Struct fields of this type are read by `Reader` without parsing, so with the conversion macros
+         * a sub-document is copied from the input to the output without being built or re-serialized.
+         * Comparison is textual, `{"a":1}` and `{ "a": 1 }` are different.
+         * @code
+         * struct Event {
+         *     Json::String id;
+         *     Json::Raw metadata;   // kept as text
+         *     // M_VCT_TOOLS_JSON_CONVERSION_FUNCTION / M_VCT_TOOLS_JSON_CONSTRUCTOR_FUNCTION ...
+         * };
+         * @endcode
+         */
+        class Raw {
+            friend class Reader;
+
+            String m_text{ "null" };
+
+            explicit Raw(const std::string_view text) : m_text(text) {}
+
+        public:
+            /**
+             * @brief Create a `null` value.
+             */
+            Raw() = default;
+
+            /**
+             * @brief Create from a Json value, same text as `json.dump()`.
+             */
+            explicit Raw(const Json& json) : m_text(json.dump()) {}
+
+            /**
+             * @brief Create from JSON text, surrounding spaces are removed.
+             * @return The value, or the same ParseError as `Json::parse` if the text is not exactly one JSON value.
+             */
+            [[nodiscard]]
+            static std::expected<Raw, ParseError> from(const std::string_view text, const std::int32_t max_depth = 256) {
+                auto it = text.begin();
+                const auto end_ptr = text.end();
+                if (const auto error = skip_value(it, end_ptr, max_depth); error != ParseError::eNone) return std::unexpected( error );
+                const auto last = it;
+                while(it != end_ptr && std::isspace(*it)) ++it;
+                if(it != end_ptr) return std::unexpected( ParseError::eRedundantText );
+                auto first = text.begin();
+                while(std::isspace(*first)) ++first;
+                return Raw{ std::string_view{ first, last } };
+            }
+
+            /**
+             * @brief The JSON text.
+             */
+            [[nodiscard]]
+            std::string_view text() const noexcept { return m_text; }
+
+            /**
+             * @brief Parse the text into a Json.
+             * @note The text is always valid, no depth limit is applied because it was checked on creation.
+             */
+            explicit operator Json() const {
+                return Json::parse(m_text, std::numeric_limits<std::int32_t>::max()).value();
+            }
+
+            bool operator==(const Raw& other) const noexcept = default;
+        };
+
+        /**
+         * @brief Streaming JSON writer, writes values directly to the output without building a Json tree.
+         * @details
+         * Uses the same escaping and number formatting as `Json::write`.
+         * Output to a `String` is appended directly, output to a stream or a sink callback
+         * is collected in an internal buffer and flushed in large blocks.
+         * Nesting (keys only in objects, matched `end_*` calls, a single root value) is validated in debug builds only,
+         * by throwing `std::logic_error`.
+         * @code
+         * Json::String out;
+         * Json::Writer writer{ out };
+         * writer.begin_object().key("id").value(1).key("tags").begin_array().value("a").end_array().end_object();
+         * @endcode
+         */
+        class Writer {
+        public:
+            /**
+             * @brief A sink callback that receives blocks of output text.
+             */
+            using Sink = std::function<void(std::string_view)>;
+
+        private:
+            static constexpr std::size_t flush_size = 16384;
+            String m_buffer;
+            String* m_out;
+            Sink m_sink;
+            bool m_comma{ false };
+        #ifndef NDEBUG
+            std::vector<char> m_stack;
+            bool m_expect_key{ false };
+            bool m_root_done{ false };
+
+            void check(const bool condition, const char* const message) const {
+                if (!condition) throw std::logic_error(message);
+            }
+        #endif
+
+            void before_value() {
+            #ifndef NDEBUG
+                check(m_stack.empty() || m_stack.back() == '[' || !m_expect_key, "Json::Writer: key expected in object.");
+                check(!m_stack.empty() || !m_root_done, "Json::Writer: more than one root value.");
+            #endif
+                if (m_comma) m_out->push_back(',');
+            }
+
+            void after_value() {
+                m_comma = true;
+            #ifndef NDEBUG
+                m_expect_key = !m_stack.empty() && m_stack.back() == '{';
+                m_root_done = m_stack.empty();
+            #endif
+                if (m_sink && m_buffer.size() >= flush_size) flush();
+            }
+
+            template<typename T>
+            static constexpr bool writes_json = requires (const T& val, String& out) { val.write_json(out); };
+
+            template<typename T>
+            static constexpr bool writes_range = !std::is_same_v<T, Json> && !writes_json<T> &&
+                !std::is_convertible_v<const T&, std::string_view> &&
+                (constructible_map<Json, T> || constructible_array<Json, T>);
+
+        public:
+            /**
+             * @brief Write to the end of a string.
+             */
+            explicit Writer(String& out) noexcept : m_out(&out) {}
+
+            /**
+             * @brief Write to an output stream, the internal buffer is flushed in large blocks.
+             */
+            explicit Writer(std::ostream& out) : m_out(&m_buffer), m_sink([&out](const std::string_view text) {
+                out.write(text.data(), static_cast<std::streamsize>(text.size()));
+            }) {}
+
+            /**
+             * @brief Write to a sink callback, the internal buffer is flushed in large blocks.
+             */
+            explicit Writer(Sink sink) : m_out(&m_buffer), m_sink(std::move(sink)) {}
+
+            Writer(const Writer&) = delete;
+            Writer& operator=(const Writer&) = delete;
+
+            /**
+             * @brief Flush the remaining output, exceptions from the sink are discarded.
+             */
+            ~Writer() noexcept {
+                try { flush(); } catch (...) {}
+            }
+
+            /**
+             * @brief Pass the buffered output to the stream or sink, no effect for string output.
+             */
+            Writer& flush() {
+                if (m_sink && !m_buffer.empty()) {
+                    m_sink(m_buffer);
+                    m_buffer.clear();
+                }
+                return *this;
+            }
+
+            Writer& begin_object() {
+                before_value();
+                m_out->push_back('{');
+                m_comma = false;
+            #ifndef NDEBUG
+                m_stack.push_back('{');
+                m_expect_key = true;
+            #endif
+                return *this;
+            }
+
+            Writer& end_object() {
+            #ifndef NDEBUG
+                check(!m_stack.empty() && m_stack.back() == '{', "Json::Writer: end_object without begin_object.");
+                check(m_expect_key, "Json::Writer: value expected after key.");
+                m_stack.pop_back();
+            #endif
+                m_out->push_back('}');
+                after_value();
+                return *this;
+            }
+
+            Writer& begin_array() {
+                before_value();
+                m_out->push_back('[');
+                m_comma = false;
+            #ifndef NDEBUG
+                m_stack.push_back('[');
+            #endif
+                return *this;
+            }
+
+            Writer& end_array() {
+            #ifndef NDEBUG
+                check(!m_stack.empty() && m_stack.back() == '[', "Json::Writer: end_array without begin_array.");
+                m_stack.pop_back();
+            #endif
+                m_out->push_back(']');
+                after_value();
+                return *this;
+            }
+
+            /**
+             * @brief Write an object key, it will be escaped.
+             */
+            Writer& key(const std::string_view name) {
+            #ifndef NDEBUG
+                check(!m_stack.empty() && m_stack.back() == '{' && m_expect_key, "Json::Writer: key outside object or after key.");
+                m_expect_key = false;
+            #endif
+                if (m_comma) m_out->push_back(',');
+                escape_to(*m_out, name);
+                m_out->push_back(':');
+                m_comma = false;
+                return *this;
+            }
+
+            /**
+             * @brief Write an object key that is already escaped, it is copied as-is.
+             * @details Used by the conversion macros, whose field names are known at compile time.
+             */
+            Writer& raw_key(const std::string_view name) {
+            #ifndef NDEBUG
+                check(!m_stack.empty() && m_stack.back() == '{' && m_expect_key, "Json::Writer: key outside object or after key.");
+                m_expect_key = false;
+            #endif
+                if (m_comma) m_out->push_back(',');
+                m_out->push_back('\"');
+                m_out->append(name.data(), name.size());
+                m_out->append("\":", 2);
+                m_comma = false;
+                return *this;
+            }
+
+            /**
+             * @brief Check if a key can be written by `raw_key` without escaping.
+             */
+            static constexpr bool is_raw_key(const std::string_view name) noexcept {
+                for (const char c : name) {
+                    if (escape_table[static_cast<unsigned char>(c)] != 0) return false;
+                }
+                return true;
+            }
+
+            /**
+             * @brief Write a value.
+             * @details
+             * 1. Null -> `null`
+             * 2. Bool -> `true` or `false`
+             * 3. arithmetic and enum types -> Number
+             * 4. types convertible to `std::string_view` -> String
+             * 5. Json -> same as `Json::write`; Raw -> its text, as-is
+             * 6. types with a `write_json(String&)` member (generated by the conversion macros) -> written by it
+             * 7. map-like and array-like ranges -> Object and Array, element by element
+             * 8. other types Json is constructible from -> converted to Json, then written
+             */
+            template<typename T>
+            requires std::is_same_v<T, Json> || std::is_same_v<T, Raw> || std::is_convertible_v<const T&, std::string_view> || std::is_constructible_v<Json, const T&> || writes_json<T>
+            Writer& value(const T& val) {
+                if constexpr (writes_range<T>) {
+                    if constexpr (constructible_map<Json, T>) {
+                        begin_object();
+                        for (const auto& [name, item] : val) {
+                            key(name);
+                            value(item);
+                        }
+                        end_object();
+                    } else {
+                        begin_array();
+                        for (const auto& item : val) value(item);
+                        end_array();
+                    }
+                } else {
+                    before_value();
+                    if constexpr (std::is_same_v<T, Null>) {
+                        m_out->append("null", 4);
+                    } else if constexpr (std::is_same_v<T, Bool>) {
+                        if (val) m_out->append("true", 4);
+                        else m_out->append("false", 5);
+                    } else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+                        number_to(*m_out, static_cast<Number>(val));
+                    } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+                        escape_to(*m_out, static_cast<std::string_view>(val));
+                    } else if constexpr (std::is_same_v<T, Json>) {
+                        val.write_to(*m_out);
+                    } else if constexpr (std::is_same_v<T, Raw>) {
+                        m_out->append(val.text().data(), val.text().size());
+                    } else if constexpr (writes_json<T>) {
+                        val.write_json(*m_out);
+                    } else {
+                        Json{ val }.write_to(*m_out);
+                    }
+                    after_value();
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Write a `null` value.
+             */
+            Writer& null() { return value(nullptr); }
+        };
+
+        /**
+         * @brief Read JSON text directly into C++ objects, without building a Json tree for them.
+         * @details Used by the `read_json` function generated by the constructor macros.
+         * Conversions are the same as `move_if`, strings, arrays and types with `read_json` are read in place,
+         * other values are parsed to a Json first and then converted.
+         */
+        class Reader {
+            using Iterator = std::string_view::const_iterator;
+
+            Iterator m_it;
+            Iterator m_end;
+            std::int32_t m_depth;
+            ParseError m_error{ ParseError::eNone };
+            String m_key;
+
+            template<typename T>
+            static constexpr bool reads_json = requires (T& val, Reader& in) { val.read_json(in); };
+
+            template<typename T, typename D>
+            static constexpr bool reads_array = convertible_array<Json, T, D> &&
+                !std::is_constructible_v<T, Json> && !std::is_convertible_v<Array, T>;
+
+            bool fail(const ParseError error) noexcept {
+                if (m_error == ParseError::eNone) m_error = error;
+                return false;
+            }
+
+            void skip_spaces() {
+                while (m_it != m_end && std::isspace(*m_it)) ++m_it;
+            }
+
+            /**
+             * @brief Read a string without escapes as a view of the text, others are unescaped to `m_key`.
+             */
+            bool key_next(std::string_view& key) {
+                const char* const begin = std::to_address(m_it) + 1;
+                const char* const end = find_escape(begin, std::to_address(m_end));
+                if (end != std::to_address(m_end) && *end == '\"') {
+                    key = std::string_view{ begin, static_cast<std::size_t>(end - begin) };
+                    m_it += end - begin + 2;
+                    return true;
+                }
+                auto str = unescape_next(m_it, m_end);
+                if (!str) return fail(str.error());
+                m_key = std::move(*str);
+                key = m_key;
+                return true;
+            }
+
+            bool string_next(String& out) {
+                const char* const begin = std::to_address(m_it) + 1;
+                const char* const end = find_escape(begin, std::to_address(m_end));
+                if (end != std::to_address(m_end) && *end == '\"') {
+                    out.assign(begin, end);
+                    m_it += end - begin + 2;
+                    return true;
+                }
+                auto str = unescape_next(m_it, m_end);
+                if (!str) return fail(str.error());
+                out = std::move(*str);
+                return true;
+            }
+
+            template<typename T, typename D>
+            bool array_next(T& out, const D& default_range_elem) {
+                if (m_depth < 0) return fail(ParseError::eDepthExceeded);
+                --m_depth;
+                ++m_it;
+                T result{};
+                while (m_it != m_end) {
+                    skip_spaces();
+                    if (m_it == m_end || *m_it == ']') break;
+                    typename T::value_type elem{};
+                    if (value(elem)) result.emplace_back(std::move(elem));
+                    else if (m_error == ParseError::eNone) result.emplace_back(default_range_elem);
+                    else return false;
+
+                    skip_spaces();
+                    if (m_it == m_end) break;
+                    if (*m_it == ',') ++m_it;
+                    else if (*m_it != ']') return fail(ParseError::eUnknownFormat);
+                }
+                if (m_it == m_end) return fail(ParseError::eUnclosedArray);
+                ++m_it;
+                ++m_depth;
+                out = std::move(result);
+                return true;
+            }
+
+        public:
+            /**
+             * @brief Create a reader over the text.
+             * @param text The JSON text, must outlive the reader.
+             * @param max_depth The maximum depth of nested structures allowed (default is 256).
+             */
+            explicit Reader(const std::string_view text, const std::int32_t max_depth = 256) noexcept
+                : m_it(text.begin()), m_end(text.end()), m_depth(max_depth - 1) {}
+
+            /**
+             * @brief The first error that occurred, `ParseError::eNone` if none.
+             */
+            [[nodiscard]]
+            ParseError error() const noexcept { return m_error; }
+
+            /**
+             * @brief Hash of an object key, used to dispatch keys to fields.
+             */
+            [[nodiscard]]
+            static constexpr std::uint64_t key_hash(const std::string_view name) noexcept {
+                std::uint64_t hash = 14695981039346656037ull;
+                for (const char c : name) {
+                    hash ^= static_cast<unsigned char>(c);
+                    hash *= 1099511628211ull;
+                }
+                return hash;
+            }
+
+            /**
+             * @brief Read the next value into `out`, with the same conversion as `move_if`.
+             * @return false if the value cannot be converted, or an error occurred, `out` is unchanged in the first case.
+             */
+            template<typename T, typename D = Null>
+            requires convertible<Json, T> || convertible_map<Json, T, D> || convertible_array<Json, T, D>
+            bool value(T& out, const D& default_range_elem = D{}) {
+                if (m_error != ParseError::eNone) return false;
+                skip_spaces();
+                if (m_it == m_end) return fail(ParseError::eUnknownFormat);
+                if constexpr (std::is_same_v<T, Raw>) {
+                    const Iterator begin = m_it;
+                    if (const auto error = skip_next(m_it, m_end, m_depth); error != ParseError::eNone) return fail(error);
+                    out = Raw{ std::string_view{ begin, m_it } };
+                    return true;
+                } else if constexpr (std::is_same_v<T, String>) {
+                    if (*m_it == '\"') return string_next(out);
+                } else if constexpr (std::is_same_v<T, Number>) {
+                    if (*m_it == '-' || std::isdigit(*m_it)) {
+                        auto number = number_next(m_it, m_end);
+                        if (!number) return fail(number.error());
+                        out = *number;
+                        return true;
+                    }
+                } else if constexpr (reads_json<T>) {
+                    if (*m_it == '{') {
+                        out.read_json(*this);
+                        return m_error == ParseError::eNone;
+                    }
+                } else if constexpr (reads_array<T, D>) {
+                    if (*m_it == '[') return array_next(out, default_range_elem);
+                }
+                auto json = reader(m_it, m_end, m_depth);
+                if (!json) return fail(json.error());
+                if constexpr (std::is_same_v<T, Json>) {
+                    out = std::move(*json);
+                } else {
+                    auto result = json->template move_if<T, D>(default_range_elem);
+                    if (!result) return false;
+                    out = std::move(*result);
+                }
+                return true;
+            }
+
+            /**
+             * @brief Read an object, `field(hash, key)` is called for each key with the reader at the value.
+             * @details `field` reads the value and returns true, or returns false to skip it.
+             * `field` is called for every occurrence of a key. To match `Json::parse`, which keeps the first value,
+             * return false for a key that was already read (the generated `read_json` does).
+             */
+            template<typename F>
+            void read_object(F&& field) {
+                if (m_error != ParseError::eNone) return;
+                skip_spaces();
+                if (m_it == m_end || *m_it != '{') {
+                    fail(ParseError::eUnknownFormat);
+                    return;
+                }
+                if (m_depth < 0) {
+                    fail(ParseError::eDepthExceeded);
+                    return;
+                }
+                --m_depth;
+                ++m_it;
+                while (m_it != m_end) {
+                    skip_spaces();
+                    if (m_it == m_end || *m_it == '}') break;
+                    if (*m_it != '\"') {
+                        fail(ParseError::eUnknownFormat);
+                        return;
+                    }
+                    std::string_view key;
+                    if (!key_next(key)) return;
+                    skip_spaces();
+                    if (m_it == m_end || *m_it != ':') {
+                        fail(ParseError::eUnknownFormat);
+                        return;
+                    }
+                    ++m_it;
+                    skip_spaces();
+                    if (m_it == m_end) break;
+                    if (!field(key_hash(key), key)) {
+                        if (const auto error = skip_next(m_it, m_end, m_depth); error != ParseError::eNone) fail(error);
+                    }
+                    if (m_error != ParseError::eNone) return;
+
+                    skip_spaces();
+                    if (m_it == m_end) break;
+                    if (*m_it == ',') ++m_it;
+                    else if (*m_it != '}') {
+                        fail(ParseError::eUnknownFormat);
+                        return;
+                    }
+                }
+                if (m_it == m_end) {
+                    fail(ParseError::eUnclosedObject);
+                    return;
+                }
+                ++m_it;
+                ++m_depth;
+            }
+
+            /**
+             * @brief Parse a whole JSON text into a `T`.
+             * @param text The JSON text.
+             * @param default_range_elem Same as `to_if`, the default element of range types.
+             * @param max_depth The maximum depth of nested structures allowed (default is 256).
+             * @return The result, `T{}` if the text is valid but cannot be converted, or a ParseError.
+             */
+            template<typename T, typename D = Null>
+            requires std::is_default_constructible_v<T> && (convertible<Json, T> || convertible_map<Json, T, D> || convertible_array<Json, T, D>)
+            [[nodiscard]]
+            static std::expected<T, ParseError> parse(
+                const std::string_view text,
+                const D default_range_elem = D{},
+                const std::int32_t max_depth = 256
+            ) {
+                Reader in{ text, max_depth };
+                in.skip_spaces();
+                if (in.m_it == in.m_end) return std::unexpected( ParseError::eEmptyData );
+                T result{};
+                in.value(result, default_range_elem);
+                if (in.m_error != ParseError::eNone) return std::unexpected( in.m_error );
+                in.skip_spaces();
+                if (in.m_it != in.m_end) return std::unexpected( ParseError::eRedundantText );
+                return result;
+            }
+        };
+
+        /**
+         * @brief Extracts the values of a set of JSON Pointers from raw text in one forward pass.
+         * @details
+         * Only the containers on the way to a requested value are entered, all other subtrees are validated
+         * and skipped without creating any value. The scan stops as soon as every pointer has been found,
+         * the rest of the text is not read (and not validated) in this case.
+         * If a key appears more than once, the first value is used, same as `Json::parse`.
+         * @code
+         * Json::Extractor extractor{ std::vector{ *Json::Pointer::parse("/route"), *Json::Pointer::parse("/meta/level") } };
+         * auto values = extractor.raw(line);    // std::optional<std::string_view> per pointer
+         * @endcode
+         */
+        class Extractor {
+            using Iterator = std::string_view::const_iterator;
+
+            struct State {
+                std::vector<std::optional<std::string_view>> found;
+                std::size_t remaining;
+            };
+
+            std::vector<Pointer, AllocatorType<Pointer>> m_pointers;
+
+            static void skip_spaces(Iterator& it, const Iterator end) {
+                while (it != end && std::isspace(*it)) ++it;
+            }
+
+            // scan the value at `it`, `active` are the pointers whose first `level` tokens lead here
+            ParseError scan(Iterator& it, const Iterator end, const std::int32_t max_depth, const std::size_t level,
+                const std::vector<std::size_t>& active, State& state
+            ) const {
+                const Iterator begin = it;
+                const bool deeper = std::ranges::any_of(active, [&](const std::size_t index) {
+                    return m_pointers[index].tokens().size() > level;
+                });
+                ParseError error;
+                if (!deeper) error = skip_next(it, end, max_depth);
+                else if (*it == '{') error = scan_object(it, end, max_depth, level, active, state);
+                else if (*it == '[') error = scan_array(it, end, max_depth, level, active, state);
+                else error = skip_next(it, end, max_depth);
+                if (error != ParseError::eNone || state.remaining == 0) return error;
+                for (const std::size_t index : active) {
+                    if (m_pointers[index].tokens().size() == level && !state.found[index]) {
+                        state.found[index] = std::string_view{ begin, it };
+                        --state.remaining;
+                    }
+                }
+                return ParseError::eNone;
+            }
+
+            ParseError scan_object(Iterator& it, const Iterator end, const std::int32_t max_depth, const std::size_t level,
+                const std::vector<std::size_t>& active, State& state
+            ) const {
+                if (max_depth < 0) return ParseError::eDepthExceeded;
+                ++it;
+                std::vector<std::size_t> next;
+                std::vector<String, AllocatorType<String>> entered; // keys already scanned, later duplicates are ignored like `Json::parse`
+                String unescaped;
+                while (it != end) {
+                    skip_spaces(it, end);
+                    if (it == end || *it == '}') break;
+                    if (*it != '\"') return ParseError::eUnknownFormat;
+                    std::string_view key;
+                    const char* const begin = std::to_address(it) + 1;
+                    const char* const stop = find_escape(begin, std::to_address(end));
+                    if (stop != std::to_address(end) && *stop == '\"') {
+                        key = std::string_view{ begin, static_cast<std::size_t>(stop - begin) };
+                        it += stop - begin + 2;
+                    } else {
+                        auto str = unescape_next(it, end);
+                        if (!str) return str.error();
+                        unescaped = std::move(*str);
+                        key = unescaped;
+                    }
+                    skip_spaces(it, end);
+                    if (it == end || *it != ':') return ParseError::eUnknownFormat;
+                    ++it;
+                    skip_spaces(it, end);
+                    if (it == end) break;
+
+                    next.clear();
+                    if (std::ranges::find(entered, key) == entered.end()) {
+                        for (const std::size_t index : active) {
+                            const auto tokens = m_pointers[index].tokens();
+                            if (tokens.size() > level && tokens[level].key == key) next.push_back(index);
+                        }
+                        if (!next.empty()) entered.emplace_back(key);
+                    }
+                    const ParseError error = next.empty()
+                        ? skip_next(it, end, max_depth - 1)
+                        : scan(it, end, max_depth - 1, level + 1, next, state);
+                    if (error != ParseError::eNone || state.remaining == 0) return error;
+
+                    skip_spaces(it, end);
+                    if (it == end) break;
+                    if (*it == ',') ++it;
+                    else if (*it != '}') return ParseError::eUnknownFormat;
+                }
+                if (it == end) return ParseError::eUnclosedObject;
+                ++it;
+                return ParseError::eNone;
+            }
+
+            ParseError scan_array(Iterator& it, const Iterator end, const std::int32_t max_depth, const std::size_t level,
+                const std::vector<std::size_t>& active, State& state
+            ) const {
+                if (max_depth < 0) return ParseError::eDepthExceeded;
+                ++it;
+                std::vector<std::size_t> next;
+                for (std::size_t i = 0; it != end; ++i) {
+                    skip_spaces(it, end);
+                    if (it == end || *it == ']') break;
+
+                    next.clear();
+                    for (const std::size_t index : active) {
+                        const auto tokens = m_pointers[index].tokens();
+                        if (tokens.size() > level && tokens[level].index == i) next.push_back(index);
+                    }
+                    const ParseError error = next.empty()
+                        ? skip_next(it, end, max_depth - 1)
+                        : scan(it, end, max_depth - 1, level + 1, next, state);
+                    if (error != ParseError::eNone || state.remaining == 0) return error;
+
+                    skip_spaces(it, end);
+                    if (it == end) break;
+                    if (*it == ',') ++it;
+                    else if (*it != ']') return ParseError::eUnknownFormat;
+                }
+                if (it == end) return ParseError::eUnclosedArray;
+                ++it;
+                return ParseError::eNone;
+            }
+
+        public:
+            /**
+             * @brief Create an extractor for a set of pointers.
+             */
+            explicit Extractor(const std::span<const Pointer> pointers) : m_pointers(pointers.begin(), pointers.end()) {}
+
+            /**
+             * @brief The requested pointers, results are in the same order.
+             */
+            [[nodiscard]]
+            std::span<const Pointer> pointers() const noexcept { return m_pointers; }
+
+            /**
+             * @brief Find the raw text of each requested value.
+             * @param text The JSON text, the results are views into it.
+             * @param max_depth The maximum nesting depth, same as `Json::parse`.
+             * @return For each pointer the text of its value, or std::nullopt if it does not exist; or a ParseError.
+             */
+            [[nodiscard]]
+            std::expected<std::vector<std::optional<std::string_view>>, ParseError> raw(
+                const std::string_view text,
+                const std::int32_t max_depth = 256
+            ) const {
+                State state{ std::vector<std::optional<std::string_view>>(m_pointers.size()), m_pointers.size() };
+                auto it = text.begin();
+                const auto end = text.end();
+                skip_spaces(it, end);
+                if (it == end) return std::unexpected( ParseError::eEmptyData );
+                std::vector<std::size_t> active(m_pointers.size());
+                std::iota(active.begin(), active.end(), std::size_t{ 0 });
+                if (const auto error = scan(it, end, max_depth - 1, 0, active, state); error != ParseError::eNone) return std::unexpected( error );
+                if (state.remaining == 0) return std::move(state.found);
+                skip_spaces(it, end);
+                if (it != end) return std::unexpected( ParseError::eRedundantText );
+                return std::move(state.found);
+            }
+
+            /**
+             * @brief Find and parse each requested value.
+             * @return For each pointer its value, or std::nullopt if it does not exist; or a ParseError.
+             */
+            [[nodiscard]]
+            std::expected<std::vector<std::optional<Json>>, ParseError> extract(
+                const std::string_view text,
+                const std::int32_t max_depth = 256
+            ) const {
+                auto found = raw(text, max_depth);
+                if (!found) return std::unexpected( found.error() );
+                std::vector<std::optional<Json>> result;
+                result.reserve(found->size());
+                for (const auto& slice : *found) {
+                    if (!slice) {
+                        result.emplace_back();
+                        continue;
+                    }
+                    auto value = parse(*slice, max_depth);
+                    if (!value) return std::unexpected( value.error() );
+                    result.emplace_back(std::move(*value));
+                }
+                return result;
+            }
+        };
+
+        /**
+         * @brief A read-mostly layout for arrays of objects that share the same keys.
+         * @details The keys are stored once, the values of each record are stored flat in key order,
+         * so a field is found by its slot instead of a map lookup, and a column is a strided walk.
+         * Use `from` to build it from an array, or `parse` to build it from text with one shared key table,
+         * and `to_json` to convert it back.
+         */
+        class Records {
+            std::vector<String, AllocatorType<String>> m_keys;
+            Array m_values;
+            std::size_t m_rows{};
+
+            template<typename T>
+            static std::optional<Records> build(T&& array) {
+                if (!array.is_arr()) return std::nullopt;
+                auto& source = array.arr();
+                Records records;
+                if (source.empty()) return records;
+                if (!source.front().is_obj()) return std::nullopt;
+                for (const auto& [key, val] : source.front().obj()) records.m_keys.emplace_back(key);
+                const std::size_t width = records.m_keys.size();
+                // check every shape before taking any value, so `array` is untouched on failure
+                for (const auto& record : source) {
+                    if (!record.is_obj() || record.obj().size() != width) return std::nullopt;
+                    for (const auto& key : records.m_keys) {
+                        if (!record.obj().contains(key)) return std::nullopt;
+                    }
+                }
+                records.m_values.reserve(width * source.size());
+                for (auto& record : source) {
+                    for (const auto& key : records.m_keys) {
+                        if constexpr (std::is_const_v<std::remove_reference_t<T>>) records.m_values.emplace_back(*record.find(key));
+                        else records.m_values.emplace_back(std::move(*record.find(key)));
+                    }
+                }
+                records.m_rows = source.size();
+                if constexpr (!std::is_const_v<std::remove_reference_t<T>>) array = Array{};
+                return records;
+            }
+
+        public:
+            Records() = default;
+
+            /**
+             * @brief Copy an array of objects with the same key set into a Records.
+             * @return std::nullopt if `array` is not an array, or its elements are not objects with the same keys.
+             */
+            [[nodiscard]]
+            static std::optional<Records> from(const Json& array) { return build(array); }
+
+            /**
+             * @brief Move the values of an array of objects with the same key set into a Records.
+             * @return std::nullopt if the shapes differ, `array` is unchanged in this case.
+             * On success `array` becomes an empty array.
+             */
+            [[nodiscard]]
+            static std::optional<Records> from(Json&& array) { return build(array); }
+
+            /**
+             * @brief Parse a JSON array of objects with the same key set directly into a Records.
+             * @details The key table is built while parsing: each distinct key is stored once, later occurrences
+             * are compared in place against the table and never allocated. A key is first compared with the slot
+             * after the previous key, so records that list their keys in the same order need no search.
+             * Slots follow the key order of the first record. A duplicated key keeps its first value, like `Json::parse`.
+             * @param text The JSON text.
+             * @param max_depth The maximum nesting depth, same as `Json::parse`.
+             * @return The result, or a ParseError. Valid JSON that is not an array of objects with the same keys is
+             * `ParseError::eUnknownFormat`, use `Json::parse` and `from` for such text.
+             */
+            [[nodiscard]]
+            static std::expected<Records, ParseError> parse(const std::string_view text, const std::int32_t max_depth = 256) {
+                auto it = text.begin();
+                const auto end = text.end();
+                const auto skip_spaces = [&it, end] { while (it != end && std::isspace(*it)) ++it; };
+                skip_spaces();
+                if (it == end) return std::unexpected( ParseError::eEmptyData );
+                if (max_depth < 1) return std::unexpected( ParseError::eDepthExceeded );
+                if (*it != '[') return std::unexpected( ParseError::eUnknownFormat );
+                ++it;
+                Records records;
+                std::vector<bool> filled;   // slots of the current record that already have a value
+                String unescaped;
+                while (it != end) {
+                    skip_spaces();
+                    if (it == end || *it == ']') break;
+                    if (max_depth < 2) return std::unexpected( ParseError::eDepthExceeded );
+                    if (*it != '{') return std::unexpected( ParseError::eUnknownFormat );
+                    ++it;
+                    const bool first = records.m_rows == 0;
+                    const std::size_t base = records.m_values.size();
+                    if (!first) {
+                        records.m_values.resize(base + records.m_keys.size());
+                        filled.assign(filled.size(), false);
+                    }
+                    std::size_t count = 0, hint = 0;
+                    while (it != end) {
+                        skip_spaces();
+                        if (it == end || *it == '}') break;
+                        if (*it != '\"') return std::unexpected( ParseError::eUnknownFormat );
+                        std::string_view key;
+                        const char* const begin = std::to_address(it) + 1;
+                        const char* const stop = find_escape(begin, std::to_address(end));
+                        if (stop != std::to_address(end) && *stop == '\"') {
+                            key = std::string_view{ begin, static_cast<std::size_t>(stop - begin) };
+                            it += stop - begin + 2;
+                        } else {
+                            auto str = unescape_next(it, end);
+                            if (!str) return std::unexpected( str.error() );
+                            unescaped = std::move(*str);
+                            key = unescaped;
+                        }
+                        skip_spaces();
+                        if (it == end || *it != ':') return std::unexpected( ParseError::eUnknownFormat );
+                        ++it;
+                        skip_spaces();
+                        if (it == end) break;
+
+                        std::size_t slot = hint;
+                        if (slot >= records.m_keys.size() || records.m_keys[slot] != key) {
+                            slot = records.slot(key).value_or(records.m_keys.size());
+                        }
+                        if (slot == records.m_keys.size()) {
+                            if (!first) return std::unexpected( ParseError::eUnknownFormat );
+                            records.m_keys.emplace_back(key);
+                            records.m_values.emplace_back();
+                            filled.push_back(false);
+                        }
+                        hint = slot + 1;
+                        if (filled[slot]) {
+                            if (const auto error = skip_next(it, end, max_depth - 3); error != ParseError::eNone) return std::unexpected( error );
+                        } else {
+                            auto value = reader(it, end, max_depth - 3);
+                            if (!value) return std::unexpected( value.error() );
+                            records.m_values[base + slot] = std::move(*value);
+                            filled[slot] = true;
+                            ++count;
+                        }
+
+                        skip_spaces();
+                        if (it == end) break;
+                        if (*it == ',') ++it;
+                        else if (*it != '}') return std::unexpected( ParseError::eUnknownFormat );
+                    }
+                    if (it == end) return std::unexpected( ParseError::eUnclosedObject );
+                    ++it;
+                    if (count != records.m_keys.size()) return std::unexpected( ParseError::eUnknownFormat );
+                    ++records.m_rows;
+
+                    skip_spaces();
+                    if (it == end) break;
+                    if (*it == ',') ++it;
+                    else if (*it != ']') return std::unexpected( ParseError::eUnknownFormat );
+                }
+                if (it == end) return std::unexpected( ParseError::eUnclosedArray );
+                ++it;
+                skip_spaces();
+                if (it != end) return std::unexpected( ParseError::eRedundantText );
+                return records;
+            }
+
+            /**
+             * @brief Number of records.
+             */
+            [[nodiscard]]
+            std::size_t size() const noexcept { return m_rows; }
+
+            /**
+             * @brief Number of keys in each record.
+             */
+            [[nodiscard]]
+            std::size_t width() const noexcept { return m_keys.size(); }
+
+            /**
+             * @brief The shared keys, in slot order.
+             */
+            [[nodiscard]]
+            std::span<const String> keys() const noexcept { return m_keys; }
+
+            /**
+             * @brief Resolve a key to its slot, resolve once and reuse the slot for all records.
+             */
+            [[nodiscard]]
+            std::optional<std::size_t> slot(const std::string_view key) const noexcept {
+                for (std::size_t i = 0; i < m_keys.size(); ++i) {
+                    if (m_keys[i] == key) return i;
+                }
+                return std::nullopt;
+            }
+
+            /**
+             * @brief Access a value by record index and slot.
+             * @throws std::out_of_range if the index or slot is out of range.
+             */
+            [[nodiscard]]
+            Json& at(const std::size_t row, const std::size_t slot) {
+                if (row >= m_rows || slot >= m_keys.size()) throw std::out_of_range("Json::Records::at: out of range");
+                return m_values[row * m_keys.size() + slot];
+            }
+            [[nodiscard]]
+            const Json& at(const std::size_t row, const std::size_t slot) const {
+                if (row >= m_rows || slot >= m_keys.size()) throw std::out_of_range("Json::Records::at: out of range");
+                return m_values[row * m_keys.size() + slot];
+            }
+
+            /**
+             * @brief Find a value by record index and key.
+             * @return nullptr if the index is out of range or the key does not exist.
+             */
+            [[nodiscard]]
+            const Json* find(const std::size_t row, const std::string_view key) const noexcept {
+                const auto index = slot(key);
+                if (row >= m_rows || !index) return nullptr;
+                return &m_values[row * m_keys.size() + *index];
+            }
+
+            /**
+             * @brief The values of one record, in slot order.
+             */
+            [[nodiscard]]
+            std::span<const Json> row(const std::size_t row) const {
+                if (row >= m_rows) throw std::out_of_range("Json::Records::row: out of range");
+                return std::span<const Json>{ m_values }.subspan(row * m_keys.size(), m_keys.size());
+            }
+
+            /**
+             * @brief A view of the values in one slot, one for each record.
+             */
+            [[nodiscard]]
+            auto column(const std::size_t slot) const {
+                if (slot >= m_keys.size()) throw std::out_of_range("Json::Records::column: out of range");
+                return std::views::iota(std::size_t{ 0 }, m_rows) | std::views::transform(
+                    [values = m_values.data(), width = m_keys.size(), slot](const std::size_t row) -> const Json& {
+                        return values[row * width + slot];
+                    }
+                );
+            }
+
+            /**
+             * @brief Convert back to an array of objects.
+             */
+            [[nodiscard]]
+            Json to_json() const & {
+                Array array;
+                array.reserve(m_rows);
+                for (std::size_t row = 0; row < m_rows; ++row) {
+                    Object object;
+                    for (std::size_t slot = 0; slot < m_keys.size(); ++slot) {
+                        object.emplace(m_keys[slot], m_values[row * m_keys.size() + slot]);
+                    }
+                    array.emplace_back(std::move(object));
+                }
+                return array;
+            }
+            [[nodiscard]]
+            Json to_json() && {
+                Array array;
+                array.reserve(m_rows);
+                for (std::size_t row = 0; row < m_rows; ++row) {
+                    Object object;
+                    for (std::size_t slot = 0; slot < m_keys.size(); ++slot) {
+                        object.emplace(m_keys[slot], std::move(m_values[row * m_keys.size() + slot]));
+                    }
+                    array.emplace_back(std::move(object));
+                }
+                m_values.clear();
+                m_rows = 0;
+                return array;
+            }
+        };
+
+        /**
+         * @brief A reference-counted, read-only handle to a Json document.
+         * @details
+         * Copying a handle only increments an atomic reference count, the document itself is shared.
+         * `mutate` clones the document first if other handles still refer to it (copy-on-write),
+         * so changes are never visible through other handles.
+         * Distinct handles can be copied and read from different threads at the same time,
+         * a single handle must not be mutated while another thread uses it.
+         * @code
+         * Json::Shared config{ Json::parse(text).value() };
+         * Worker worker{ config };     // O(1) copy
+         * config.mutate()["debug"] = true;
+         * @endcode
+         */
+        class Shared {
+            std::shared_ptr<Json> m_json;
+
+        public:
+            /**
+             * @brief Create a handle to a Null document.
+             */
+            Shared() : Shared(Json{}) {}
+
+            /**
+             * @brief Create a handle that owns `json`.
+             */
+            explicit Shared(Json json) : m_json{ std::allocate_shared<Json>(AllocatorType<Json>{}, std::move(json)) } {}
+
+            /**
+             * @brief The shared document, read-only.
+             */
+            [[nodiscard]]
+            const Json& get() const noexcept { return *m_json; }
+            [[nodiscard]]
+            const Json& operator*() const noexcept { return *m_json; }
+            [[nodiscard]]
+            const Json* operator->() const noexcept { return m_json.get(); }
+
+            /**
+             * @brief Number of handles that share the document.
+             */
+            [[nodiscard]]
+            long use_count() const noexcept { return m_json.use_count(); }
+
+            /**
+             * @brief Get a mutable reference, the document is copied first if it is shared.
+             * @note The reference is valid until this handle is copied or assigned.
+             */
+            [[nodiscard]]
+            Json& mutate() {
+                if (m_json.use_count() != 1) {
+                    m_json = std::allocate_shared<Json>(AllocatorType<Json>{}, std::as_const(*m_json));
+                } else {
+                    // use_count() is a relaxed load, order the reads made by threads that released
+                    // their handles before the writes through the returned reference
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                }
+                return *m_json;
+            }
+        };
+
+        /**
+         * @brief An immutable, compact, read-optimized copy of a Json document, created by `Json::freeze`.
+         * @details
+         * All values are stored in one node vector, the children of every Array and Object in one slot vector,
+         * and all strings and keys in one character buffer.
+         * Object slots store a precomputed key hash and are sorted by (hash, key), a lookup is a binary search.
+         * Nothing is modified after construction, so any number of threads can read it without locks.
+         * Values are accessed through `View`, a (document, node) pair that is cheap to copy.
+         */
+        class Frozen {
+            struct Node {
+                Type type{ Type::eNull };
+                std::uint32_t size{};       ///< Children of Array/Object, length of String
+                std::size_t offset{};       ///< First slot of Array/Object, first character of String
+                Number number{};            ///< Number, or Bool as 0 and 1
+            };
+            struct Slot {
+                std::size_t hash{};         ///< Key hash, Object only
+                std::size_t key{};          ///< First character of the key, Object only
+                std::uint32_t key_size{};
+                std::uint32_t node{};
+            };
+
+            std::vector<Node, AllocatorType<Node>> m_nodes;
+            std::vector<Slot, AllocatorType<Slot>> m_slots;
+            String m_chars;
+
+            std::string_view chars(const std::size_t offset, const std::size_t size) const noexcept {
+                return { m_chars.data() + offset, size };
+            }
+
+            std::uint32_t add(const Json& json) {
+                const auto index = static_cast<std::uint32_t>(m_nodes.size());
+                m_nodes.emplace_back().type = json.type();
+                switch (json.type()) {
+                    case Type::eBool: m_nodes[index].number = json.bol(); break;
+                    case Type::eNumber: m_nodes[index].number = json.num(); break;
+                    case Type::eString: {
+                        m_nodes[index].offset = m_chars.size();
+                        m_nodes[index].size = static_cast<std::uint32_t>(json.str().size());
+                        m_chars.append(json.str());
+                    } break;
+                    case Type::eArray: {
+                        const std::size_t offset = m_slots.size();
+                        m_nodes[index].offset = offset;
+                        m_nodes[index].size = static_cast<std::uint32_t>(json.arr().size());
+                        m_slots.resize(offset + json.arr().size());
+                        for (std::size_t i = 0; const auto& val : json.arr()) {
+                            const std::uint32_t child = add(val);
+                            m_slots[offset + i++].node = child;
+                        }
+                    } break;
+                    case Type::eObject: {
+                        const std::size_t offset = m_slots.size();
+                        m_nodes[index].offset = offset;
+                        m_nodes[index].size = static_cast<std::uint32_t>(json.obj().size());
+                        m_slots.resize(offset + json.obj().size());
+                        for (std::size_t i = offset; const auto& [key, val] : json.obj()) {
+                            m_slots[i].hash = KeyHash{}(key);
+                            m_slots[i].key = m_chars.size();
+                            m_slots[i].key_size = static_cast<std::uint32_t>(key.size());
+                            m_chars.append(key);
+                            const std::uint32_t child = add(val);
+                            m_slots[i++].node = child;
+                        }
+                        // only this object's slots, the children's slots were appended after them
+                        const auto first = m_slots.begin() + static_cast<std::ptrdiff_t>(offset);
+                        std::ranges::sort(first, first + static_cast<std::ptrdiff_t>(json.obj().size()), [this](const Slot& a, const Slot& b) {
+                            if (a.hash != b.hash) return a.hash < b.hash;
+                            return chars(a.key, a.key_size) < chars(b.key, b.key_size);
+                        });
+                    } break;
+                    default: break;
+                }
+                return index;
+            }
+
+        public:
+            /**
+             * @brief A read-only reference to a value in a Frozen document.
+             * @note Valid as long as the document is alive.
+             */
+            class View {
+                const Frozen* m_doc;
+                std::uint32_t m_node;
+
+                const Node& node() const noexcept { return m_doc->m_nodes[m_node]; }
+                const Slot& slot(const std::size_t index) const noexcept { return m_doc->m_slots[node().offset + index]; }
+                void expect(const Type type) const {
+                    if (node().type != type) throw std::bad_variant_access{};
+                }
+
+            public:
+                View(const Frozen& doc, const std::uint32_t node) noexcept : m_doc{ &doc }, m_node{ node } {}
+
+                [[nodiscard]]
+                Type type() const noexcept { return node().type; }
+                [[nodiscard]]
+                bool is_nul() const noexcept { return type() == Type::eNull; }
+                [[nodiscard]]
+                bool is_bol() const noexcept { return type() == Type::eBool; }
+                [[nodiscard]]
+                bool is_num() const noexcept { return type() == Type::eNumber; }
+                [[nodiscard]]
+                bool is_str() const noexcept { return type() == Type::eString; }
+                [[nodiscard]]
+                bool is_arr() const noexcept { return type() == Type::eArray; }
+                [[nodiscard]]
+                bool is_obj() const noexcept { return type() == Type::eObject; }
+
+                /**
+                 * @brief Get the scalar value.
+                 * @throw std::bad_variant_access if the type does not match.
+                 */
+                [[nodiscard]]
+                Bool bol() const { expect(Type::eBool); return node().number != 0; }
+                [[nodiscard]]
+                Number num() const { expect(Type::eNumber); return node().number; }
+                [[nodiscard]]
+                std::string_view str() const { expect(Type::eString); return m_doc->chars(node().offset, node().size); }
+
+                /**
+                 * @brief Number of children of an Array or Object, 0 for other types.
+                 */
+                [[nodiscard]]
+                std::size_t size() const noexcept {
+                    return is_arr() || is_obj() ? node().size : 0;
+                }
+
+                /**
+                 * @brief Get the child at `index`, array elements in order, object members in slot order.
+                 * @throw std::out_of_range if this is not an Array or Object, or the index is out of range.
+                 */
+                [[nodiscard]]
+                View at(const std::size_t index) const {
+                    if (index >= size()) throw std::out_of_range("Json::Frozen::View::at: index out of range");
+                    return { *m_doc, slot(index).node };
+                }
+
+                /**
+                 * @brief Get the key of the object member at `index`.
+                 * @throw std::out_of_range if this is not an Object, or the index is out of range.
+                 */
+                [[nodiscard]]
+                std::string_view key(const std::size_t index) const {
+                    if (!is_obj() || index >= size()) throw std::out_of_range("Json::Frozen::View::key: index out of range");
+                    return m_doc->chars(slot(index).key, slot(index).key_size);
+                }
+
+                /**
+                 * @brief Find an object member by key, binary search on the precomputed hashes.
+                 * @return std::nullopt if this is not an Object or the key does not exist.
+                 */
+                [[nodiscard]]
+                std::optional<View> find(const std::string_view key) const noexcept {
+                    if (!is_obj()) return std::nullopt;
+                    const std::size_t hash = KeyHash{}(key);
+                    const auto first = m_doc->m_slots.begin() + node().offset;
+                    const auto last = first + node().size;
+                    for (auto it = std::ranges::lower_bound(first, last, hash, {}, &Slot::hash); it != last && it->hash == hash; ++it) {
+                        if (m_doc->chars(it->key, it->key_size) == key) return View{ *m_doc, it->node };
+                    }
+                    return std::nullopt;
+                }
+
+                /**
+                 * @brief Get an object member by key.
+                 * @throw std::out_of_range if this is not an Object or the key does not exist.
+                 */
+                [[nodiscard]]
+                View at(const std::string_view key) const {
+                    if (const auto value = find(key)) return *value;
+                    throw std::out_of_range("Json::Frozen::View::at: key not found");
+                }
+
+                /**
+                 * @brief Copy the value into a mutable Json.
+                 */
+                [[nodiscard]]
+                Json to_json() const {
+                    switch (type()) {
+                        case Type::eBool: return bol();
+                        case Type::eNumber: return num();
+                        case Type::eString: return String{ str() };
+                        case Type::eArray: {
+                            Array array;
+                            array.reserve(size());
+                            for (std::size_t i = 0; i < size(); ++i) array.emplace_back(at(i).to_json());
+                            return array;
+                        }
+                        case Type::eObject: {
+                            Object object;
+                            for (std::size_t i = 0; i < size(); ++i) object.emplace(String{ key(i) }, at(i).to_json());
+                            return object;
+                        }
+                        default: return Null{};
+                    }
+                }
+            };
+
+            /**
+             * @brief Create a frozen Null document.
+             */
+            Frozen() { m_nodes.emplace_back(); }
+
+            /**
+             * @brief Create a frozen copy of `json`.
+             */
+            explicit Frozen(const Json& json) { add(json); }
+
+            /**
+             * @brief The root value.
+             */
+            [[nodiscard]]
+            View root() const noexcept { return { *this, 0 }; }
+        };
+
+        /**
+         * @brief Create an immutable, read-optimized copy of this document.
+         * @see Frozen
+         */
+        [[nodiscard]]
+        Frozen freeze() const { return Frozen{ *this }; }
+
+        /**
+         * @brief Atomically published Frozen snapshots, for documents that are reloaded while being read.
+         * @details
+         * `load` returns the current snapshot, it stays valid for the reader even if a new one is stored meanwhile.
+         * `store` replaces the snapshot, the old one is destroyed when its last reader drops it.
+         * Readers never take a lock, and never see a partially built document.
+         */
+        class Snapshot {
+            std::atomic<std::shared_ptr<const Frozen>> m_current;
+
+        public:
+            /**
+             * @brief Start with a frozen Null document.
+             */
+            Snapshot() : Snapshot(Frozen{}) {}
+            explicit Snapshot(Frozen frozen) : m_current{ std::allocate_shared<const Frozen>(AllocatorType<Frozen>{}, std::move(frozen)) } {}
+
+            /**
+             * @brief Get the current snapshot.
+             */
+            [[nodiscard]]
+            std::shared_ptr<const Frozen> load() const noexcept { return m_current.load(std::memory_order_acquire); }
+
+            /**
+             * @brief Publish a new snapshot.
+             */
+            void store(Frozen frozen) {
+                m_current.store(std::allocate_shared<const Frozen>(AllocatorType<Frozen>{}, std::move(frozen)), std::memory_order_release);
+            }
+        };
+
+        /**
+         * @brief A read-only document stored as one contiguous tape of 64-bit words and one string buffer.
+         * @details
+         * Each value starts with a word holding its Type in the top byte and a payload in the rest:
+         * - Null, Bool: one word, the payload is the bool value.
+         * - Number: two words, the second holds the bits of the double.
+         * - String: two words, the payload is the offset in the string buffer, the second word is the length.
+         * - Array, Object: two words, the payload is the tape index after the last child, the second word is the
+         *   number of children. Children follow directly, object members as a key (a String) followed by a value.
+         *
+         * Whole subtrees are skipped by jumping to the end index, reading is a linear scan without pointer chasing.
+         * Lookups by index or key are linear in the number of children.
+         */
+        class Tape {
+            std::vector<std::uint64_t, AllocatorType<std::uint64_t>> m_words;
+            String m_chars;
+
+            static constexpr std::uint64_t payload_mask = (std::uint64_t{1} << 56) - 1;
+
+            void push(const Type type, const std::uint64_t payload) {
+                m_words.push_back(static_cast<std::uint64_t>(type) << 56 | payload);
+            }
+
+            void push_string(const std::string_view str) {
+                push(Type::eString, m_chars.size());
+                m_words.push_back(str.size());
+                m_chars.append(str);
+            }
+
+            static void measure(const Json& json, std::size_t& words, std::size_t& chars) noexcept {
+                switch (json.type()) {
+                    case Type::eNull: case Type::eBool: words += 1; break;
+                    case Type::eNumber: words += 2; break;
+                    case Type::eString: words += 2; chars += json.str().size(); break;
+                    case Type::eArray: {
+                        words += 2;
+                        for (const auto& val : json.arr()) measure(val, words, chars);
+                    } break;
+                    case Type::eObject: {
+                        words += 2;
+                        for (const auto& [key, val] : json.obj()) {
+                            words += 2;
+                            chars += key.size();
+                            measure(val, words, chars);
+                        }
+                    } break;
+                }
+            }
+
+            // upper bounds of the words and characters that `value_next` needs for `text`, from one scan:
+            // a value starts the text or follows `,`, `[` or `{`, it takes at most 2 words, and each `:` has a 2-word key
+            static void measure_text(const std::string_view text, std::size_t& words, std::size_t& chars) noexcept {
+                std::size_t values = 1, keys = 0;
+                bool in_string = false;
+                for (std::size_t i = 0; i < text.size(); ++i) {
+                    const char c = text[i];
+                    if (in_string) {
+                        if (c == '\\') {
+                            chars += 2;     // an escape sequence is never shorter than what it decodes to
+                            ++i;
+                        } else if (c == '"') in_string = false;
+                        else ++chars;
+                        continue;
+                    }
+                    switch (c) {
+                        case '"': in_string = true; break;
+                        case ',': case '[': case '{': ++values; break;
+                        case ':': ++keys; break;
+                        default: break;
+                    }
+                }
+                words = 2 * values + 2 * keys;
+            }
+
+            struct Unfilled {};
+            explicit Tape(Unfilled) noexcept {}
+
+            void add(const Json& json) {
+                switch (json.type()) {
+                    case Type::eNull: push(Type::eNull, 0); break;
+                    case Type::eBool: push(Type::eBool, json.bol()); break;
+                    case Type::eNumber: {
+                        push(Type::eNumber, 0);
+                        m_words.push_back(std::bit_cast<std::uint64_t>(json.num()));
+                    } break;
+                    case Type::eString: push_string(json.str()); break;
+                    case Type::eArray: {
+                        const std::size_t start = m_words.size();
+                        push(Type::eArray, 0);
+                        m_words.push_back(json.arr().size());
+                        for (const auto& val : json.arr()) add(val);
+                        m_words[start] |= m_words.size();
+                    } break;
+                    case Type::eObject: {
+                        const std::size_t start = m_words.size();
+                        push(Type::eObject, 0);
+                        m_words.push_back(json.obj().size());
+                        for (const auto& [key, val] : json.obj()) {
+                            push_string(key);
+                            add(val);
+                        }
+                        m_words[start] |= m_words.size();
+                    } break;
+                }
+            }
+
+            ParseError string_next(std::string_view::const_iterator& it, const std::string_view::const_iterator end) {
+                const char* const begin = std::to_address(it) + 1;
+                const char* const stop = find_escape(begin, std::to_address(end));
+                if (stop != std::to_address(end) && *stop == '\"') {
+                    push_string({ begin, static_cast<std::size_t>(stop - begin) });
+                    it += stop - begin + 2;
+                    return ParseError::eNone;
+                }
+                auto str = unescape_next(it, end);
+                if (!str) return str.error();
+                push_string(*str);
+                return ParseError::eNone;
+            }
+
+            ParseError value_next(std::string_view::const_iterator& it, const std::string_view::const_iterator end, const std::int32_t max_depth) {
+                if (max_depth < 0) return ParseError::eDepthExceeded;
+                const auto literal = [&it, end](const std::string_view word) {
+                    if (static_cast<std::size_t>(end - it) < word.size() || std::string_view{ it, it + word.size() } != word) return false;
+                    it += word.size();
+                    return true;
+                };
+                switch (*it) {
+                    case '{': case '[': {
+                        const bool is_object = *it == '{';
+                        const char close = is_object ? '}' : ']';
+                        const std::size_t start = m_words.size();
+                        push(is_object ? Type::eObject : Type::eArray, 0);
+                        m_words.push_back(0);
+                        ++it;
+                        while (it != end) {
+                            while (it != end && std::isspace(*it)) ++it;
+                            if (it == end || *it == close) break;
+                            if (is_object) {
+                                if (*it != '\"') return ParseError::eUnknownFormat;
+                                if (const auto error = string_next(it, end); error != ParseError::eNone) return error;
+                                while (it != end && std::isspace(*it)) ++it;
+                                if (it == end || *it != ':') return ParseError::eUnknownFormat;
+                                ++it;
+                                while (it != end && std::isspace(*it)) ++it;
+                                if (it == end) break;
+                            }
+                            if (const auto error = value_next(it, end, max_depth - 1); error != ParseError::eNone) return error;
+                            ++m_words[start + 1];
+
+                            while (it != end && std::isspace(*it)) ++it;
+                            if (it == end) break;
+                            if (*it == ',') ++it;
+                            else if (*it != close) return ParseError::eUnknownFormat;
+                        }
+                        if (it == end) return is_object ? ParseError::eUnclosedObject : ParseError::eUnclosedArray;
+                        ++it;
+                        m_words[start] |= m_words.size();
+                    } break;
+                    case '\"': {
+                        if (const auto error = string_next(it, end); error != ParseError::eNone) return error;
+                    } break;
+                    case 't': if (!literal("true")) return ParseError::eUnknownFormat; push(Type::eBool, 1); break;
+                    case 'f': if (!literal("false")) return ParseError::eUnknownFormat; push(Type::eBool, 0); break;
+                    case 'n': if (!literal("null")) return ParseError::eUnknownFormat; push(Type::eNull, 0); break;
+                    default: {
+                        if (*it == 'e' || *it == 'E') return ParseError::eUnknownFormat;
+                        const auto value = number_next(it, end);
+                        if (!value) return value.error();
+                        push(Type::eNumber, 0);
+                        m_words.push_back(std::bit_cast<std::uint64_t>(*value));
+                    } break;
+                }
+                return ParseError::eNone;
+            }
+
+        public:
+            /**
+             * @brief A read-only reference to a value in a Tape.
+             * @note Valid as long as the tape is alive.
+             */
+            class View {
+                const Tape* m_tape;
+                std::size_t m_index;
+
+                std::uint64_t word(const std::size_t offset = 0) const noexcept { return m_tape->m_words[m_index + offset]; }
+                void expect(const Type type) const {
+                    if (this->type() != type) throw std::bad_variant_access{};
+                }
+                // tape index after the value at `index`
+                std::size_t skip(const std::size_t index) const noexcept {
+                    const std::uint64_t header = m_tape->m_words[index];
+                    switch (static_cast<Type>(header >> 56)) {
+                        case Type::eNull: case Type::eBool: return index + 1;
+                        case Type::eNumber: case Type::eString: return index + 2;
+                        default: return header & payload_mask;
+                    }
+                }
+                // tape index of the child at `index`, for objects the index of its key
+                std::size_t child(std::size_t index) const noexcept {
+                    std::size_t pos = m_index + 2;
+                    for (; index > 0; --index) {
+                        if (is_obj()) pos += 2;
+                        pos = skip(pos);
+                    }
+                    return pos;
+                }
+                std::string_view string_at(const std::size_t index) const noexcept {
+                    const std::uint64_t header = m_tape->m_words[index];
+                    return { m_tape->m_chars.data() + (header & payload_mask), static_cast<std::size_t>(m_tape->m_words[index + 1]) };
+                }
+
+            public:
+                View(const Tape& tape, const std::size_t index) noexcept : m_tape{ &tape }, m_index{ index } {}
+
+                [[nodiscard]]
+                Type type() const noexcept { return static_cast<Type>(word() >> 56); }
+                [[nodiscard]]
+                bool is_nul() const noexcept { return type() == Type::eNull; }
+                [[nodiscard]]
+                bool is_bol() const noexcept { return type() == Type::eBool; }
+                [[nodiscard]]
+                bool is_num() const noexcept { return type() == Type::eNumber; }
+                [[nodiscard]]
+                bool is_str() const noexcept { return type() == Type::eString; }
+                [[nodiscard]]
+                bool is_arr() const noexcept { return type() == Type::eArray; }
+                [[nodiscard]]
+                bool is_obj() const noexcept { return type() == Type::eObject; }
+
+                /**
+                 * @brief Get the scalar value.
+                 * @throw std::bad_variant_access if the type does not match.
+                 */
+                [[nodiscard]]
+                Bool bol() const { expect(Type::eBool); return (word() & payload_mask) != 0; }
+                [[nodiscard]]
+                Number num() const { expect(Type::eNumber); return std::bit_cast<Number>(word(1)); }
+                [[nodiscard]]
+                std::string_view str() const { expect(Type::eString); return string_at(m_index); }
+
+                /**
+                 * @brief Number of children of an Array or Object, 0 for other types.
+                 */
+                [[nodiscard]]
+                std::size_t size() const noexcept {
+                    return is_arr() || is_obj() ? static_cast<std::size_t>(word(1)) : 0;
+                }
+
+                /**
+                 * @brief Get the array element or object member value at `index`.
+                 * @throw std::out_of_range if this is not an Array or Object, or the index is out of range.
+                 */
+                [[nodiscard]]
+                View at(const std::size_t index) const {
+                    if (index >= size()) throw std::out_of_range("Json::Tape::View::at: index out of range");
+                    return { *m_tape, child(index) + (is_obj() ? 2 : 0) };
+                }
+
+                /**
+                 * @brief Get the key of the object member at `index`.
+                 * @throw std::out_of_range if this is not an Object, or the index is out of range.
+                 */
+                [[nodiscard]]
+                std::string_view key(const std::size_t index) const {
+                    if (!is_obj() || index >= size()) throw std::out_of_range("Json::Tape::View::key: index out of range");
+                    return string_at(child(index));
+                }
+
+                /**
+                 * @brief Find an object member by key.
+                 * @return std::nullopt if this is not an Object or the key does not exist.
+                 */
+                [[nodiscard]]
+                std::optional<View> find(const std::string_view key) const noexcept {
+                    if (!is_obj()) return std::nullopt;
+                    const std::size_t end = word() & payload_mask;
+                    for (std::size_t pos = m_index + 2; pos < end; pos = skip(pos + 2)) {
+                        if (string_at(pos) == key) return View{ *m_tape, pos + 2 };
+                    }
+                    return std::nullopt;
+                }
+
+                /**
+                 * @brief Get an object member by key.
+                 * @throw std::out_of_range if this is not an Object or the key does not exist.
+                 */
+                [[nodiscard]]
+                View at(const std::string_view key) const {
+                    if (const auto value = find(key)) return *value;
+                    throw std::out_of_range("Json::Tape::View::at: key not found");
+                }
+
+                /**
+                 * @brief Copy the value into a mutable Json.
+                 */
+                [[nodiscard]]
+                Json to_json() const {
+                    switch (type()) {
+                        case Type::eBool: return bol();
+                        case Type::eNumber: return num();
+                        case Type::eString: return String{ str() };
+                        case Type::eArray: {
+                            Array array;
+                            array.reserve(size());
+                            const std::size_t end = word() & payload_mask;
+                            for (std::size_t pos = m_index + 2; pos < end; pos = skip(pos)) {
+                                array.emplace_back(View{ *m_tape, pos }.to_json());
+                            }
+                            return array;
+                        }
+                        case Type::eObject: {
+                            Object object;
+                            const std::size_t end = word() & payload_mask;
+                            for (std::size_t pos = m_index + 2; pos < end; pos = skip(pos + 2)) {
+                                object.emplace(String{ string_at(pos) }, View{ *m_tape, pos + 2 }.to_json());
+                            }
+                            return object;
+                        }
+                        default: return Null{};
+                    }
+                }
+            };
+
+            /**
+             * @brief Create a tape holding Null.
+             */
+            Tape() { push(Type::eNull, 0); }
+
+            /**
+             * @brief Convert a Json to a tape, the tape and string buffer are allocated once at their exact size.
+             */
+            explicit Tape(const Json& json) {
+                std::size_t words{}, chars{};
+                measure(json, words, chars);
+                m_words.reserve(words);
+                m_chars.reserve(chars);
+                add(json);
+            }
+
+            /**
+             * @brief Parse JSON text directly into a tape, without creating `Json` values.
+             * @param text The JSON text.
+             * @param max_depth The maximum nesting depth, same as `Json::parse`.
+             * @return The tape, or a ParseError.
+             */
+            [[nodiscard]]
+            static std::expected<Tape, ParseError> parse(const std::string_view text, const std::int32_t max_depth = 256) {
+                auto it = text.begin();
+                const auto end = text.end();
+                while (it != end && std::isspace(*it)) ++it;
+                if (it == end) return std::unexpected( ParseError::eEmptyData );
+                std::size_t words{}, chars{};
+                measure_text(text, words, chars);
+                Tape tape{ Unfilled{} };
+                tape.m_words.reserve(words);
+                tape.m_chars.reserve(chars);
+                if (const auto error = tape.value_next(it, end, max_depth - 1); error != ParseError::eNone) return std::unexpected( error );
+                while (it != end && std::isspace(*it)) ++it;
+                if (it != end) return std::unexpected( ParseError::eRedundantText );
+                return tape;
+            }
+
+            /**
+             * @brief The root value.
+             */
+            [[nodiscard]]
+            View root() const noexcept { return { *this, 0 }; }
+
+            /**
+             * @brief The tape words, for inspection.
+             */
+            [[nodiscard]]
+            std::span<const std::uint64_t> words() const noexcept { return m_words; }
+
+            /**
+             * @brief Convert the whole tape back to a mutable Json.
+             */
+            [[nodiscard]]
+            Json to_json() const { return root().to_json(); }
+        };
+
+        /**
+         * @brief Destroys released Json trees on a background thread.
+         * @details
+         * Freeing a large tree can take milliseconds, `release` moves it to a queue and returns at once.
+         * The worker thread destroys queued trees in batches. The destructor waits until the queue is drained.
+         * @code
+         * Json::Reclaimer reclaimer;
+         * reclaimer.release(std::move(document));
+         * @endcode
+         */
+        class Reclaimer {
+            std::mutex m_mutex;
+            std::condition_variable_any m_cv;
+            Array m_pending;
+            std::jthread m_thread;  // declared last, stopped and joined first
+
+            void run(const std::stop_token token) {
+                std::unique_lock lock{ m_mutex };
+                while (m_cv.wait(lock, token, [this] { return !m_pending.empty(); }) || !m_pending.empty()) {
+                    Array batch = std::move(m_pending);
+                    m_pending = Array{};
+                    lock.unlock();
+                    batch.clear();
+                    lock.lock();
+                }
+            }
+
+        public:
+            Reclaimer() : m_thread{ [this](const std::stop_token token) { run(token); } } {}
+            Reclaimer(const Reclaimer&) = delete;
+            Reclaimer& operator=(const Reclaimer&) = delete;
+
+            /**
+             * @brief Hand a tree over to the worker thread, `json` becomes Null.
+             * @note Values without children are destroyed in place, queueing them would cost more.
+             */
+            void release(Json&& json) {
+                if (!json.has_children()) {
+                    json = Null{};
+                    return;
+                }
+                {
+                    std::lock_guard lock{ m_mutex };
+                    m_pending.push_back(std::move(json));
+                }
+                m_cv.notify_one();
+            }
+
+            /**
+             * @brief Number of trees waiting to be destroyed.
+             */
+            [[nodiscard]]
+            std::size_t pending() {
+                std::lock_guard lock{ m_mutex };
+                return m_pending.size();
+            }
+        };
+
     };
 
 }
@@ -91,3 +91,58 @@ M_TEST(File, Serial_All) {
 
 
 
+
+M_TEST(File, Serial_Size) {
+    for (const auto name : { "many_all", "many_complex", "many_number", "medium_1", "simple_1" }) {
+        std::ifstream file( CURRENT_PATH "/files/" + std::string(name) + ".json" );
+        const auto json = Json::parse(file, 1024).value_or( nullptr );
+        M_ASSERT_NE( json.type(), json::Type::eNull );
+
+        const std::string plain = json.dump();
+        M_ASSERT_EQ( json.serialized_size(), plain.size() );
+
+        M_ASSERT_EQ( json.serialized_size_pretty(), json.dumpf()->size() );
+        M_ASSERT_EQ( json.serialized_size_pretty(4, 2), json.dumpf(4, 2)->size() );
+        M_ASSERT_EQ( json.serialized_size_pretty(0), json.dumpf(0)->size() );
+    }
+
+    const Json escaped{ Json::Array{ "\x01\"\\", 1.5, nullptr, false, Json::Object{}, Json::Array{} } };
+    M_ASSERT_EQ( escaped.serialized_size(), escaped.dump().size() );
+    M_ASSERT_EQ( escaped.serialized_size_pretty(), escaped.dumpf()->size() );
+}
+
+M_TEST(File, Serial_Format) {
+    std::ifstream file( CURRENT_PATH "/files/many_complex.json" );
+    const auto json = Json::parse(file).value_or( nullptr );
+    M_ASSERT_NE( json.type(), json::Type::eNull );
+
+    // Options with default indentation are equal to the classic overloads
+    M_ASSERT_EQ( json.dumpf(json::FormatOptions{ .space_num = 4, .depth = 1 }), json.dumpf(4, 1) );
+
+    const json::FormatOptions tab_options{ .space_num = 1, .indent_char = '\t', .compact_scalar_arrays = true };
+    const auto tab_text = json.dumpf(tab_options);
+    M_ASSERT_TRUE( tab_text.has_value() );
+    M_ASSERT_EQ( json.serialized_size_pretty(tab_options), tab_text->size() );
+    M_ASSERT_EQ( Json::parse(*tab_text).value_or( nullptr ), json );
+
+    const Json small = Json::parse(R"({"a":[1,"x",null],"b":[[true]],"c":[],"d":{}})").value_or( nullptr );
+    M_ASSERT_EQ( small.dumpf(tab_options), "{\n\t\"a\": [1, \"x\", null],\n\t\"b\": [\n\t\t[true]\n\t],\n\t\"c\": [],\n\t\"d\": {}\n}" );
+
+    std::ostringstream os;
+    M_ASSERT_TRUE( small.writef(os, tab_options) );
+    M_ASSERT_EQ( os.str(), small.dumpf(tab_options) );
+
+    // Indentation deeper than max_space fails
+    M_ASSERT_FALSE( small.dumpf(json::FormatOptions{ .space_num = 4, .max_space = 4 }).has_value() );
+
+    // Lines deeper than the initial prefix buffer, siblings after a deep child keep their indentation
+    Json deep{ 0 };
+    std::string expected = "0";
+    for (int i = 1; i <= 100; ++i) {
+        deep = Json{ Json::Array{ std::move(deep), i } };
+        const std::string indent(2 * (100 - i), ' ');
+        expected = "[\n" + indent + "  " + expected + ",\n" + indent + "  " + std::to_string(i) + "\n" + indent + "]";
+    }
+    M_ASSERT_EQ( deep.dumpf(), expected );
+    M_ASSERT_EQ( deep.serialized_size_pretty(), expected.size() );
+}
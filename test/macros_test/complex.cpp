@@ -233,3 +233,102 @@ M_TEST(Macros, ComplexDefaultBehavior) {
     M_ASSERT_EQ(o2.inner.name, "json_default");
     M_ASSERT_EQ(o2.inner.flag, false);
 }
+
+// 带有列表、映射和特殊键名的类型，测试 write_json 直接序列化
+struct WriteType {
+    std::vector<InnerType> list{};
+    std::map<std::string, OuterType> table{};
+    std::string text{};
+
+    WriteType() = default;
+
+    M_JSON_CV_FUN(WriteType,
+        M_JSON_CV_MEM(list)
+        M_JSON_CV_MEM(table)
+        M_JSON_CV_MAP("quoted", text)
+    )
+};
+
+M_TEST(Macros, ComplexWriteJson) {
+    OuterType o1{2.5, InnerType{7, "he\"llo", false}, "outer\n"};
+    std::string text;
+    o1.write_json(text);
+    M_ASSERT_EQ(text, R"({"value":2.5,"inner":{"id":7,"name":"he\"llo","flag":false},"desc":"outer\n"})");
+    M_ASSERT_TRUE(Json::parse(text) == Json{o1});
+
+    // write_json appends to the string
+    o1.inner.write_json(text);
+    M_ASSERT_TRUE(text.ends_with(R"(}{"id":7,"name":"he\"llo","flag":false})"));
+
+    WriteType w;
+    w.list = { InnerType{1, "A", true}, InnerType{2, "B", false} };
+    w.table = { {"a", OuterType{1.5, InnerType{3, "C", true}, "descA"}} };
+    w.text = "map field";
+    std::string w_text;
+    w.write_json(w_text);
+    M_ASSERT_EQ(w_text, R"({"list":[{"id":1,"name":"A","flag":true},{"id":2,"name":"B","flag":false}],)"
+                        R"("table":{"a":{"value":1.5,"inner":{"id":3,"name":"C","flag":true},"desc":"descA"}},)"
+                        R"("\"quoted\"":"map field"})");
+    M_ASSERT_TRUE(Json::parse(w_text) == Json{w});
+
+    // Json::Writer uses write_json for nested values
+    std::string writer_text;
+    {
+        Json::Writer writer{ writer_text };
+        writer.begin_array().value(o1.inner).value(std::vector<InnerType>{}).end_array();
+    }
+    M_ASSERT_EQ(writer_text, R"([{"id":7,"name":"he\"llo","flag":false},[]])");
+}
+
+M_TEST(Macros, ComplexReadJson) {
+    // 与构造函数的结果一致
+    const std::string text = R"({"value":2.5,"inner":{"id":7,"name":"he\"llo","flag":false},"desc":"outer"})";
+    const auto o1 = Json::Reader::parse<OuterType>(text);
+    M_ASSERT_TRUE(o1.has_value());
+    const OuterType o1_dom{ *Json::parse(text) };
+    M_ASSERT_EQ(o1->value, o1_dom.value);
+    M_ASSERT_EQ(o1->inner.id, 7);
+    M_ASSERT_EQ(o1->inner.name, o1_dom.inner.name);
+    M_ASSERT_EQ(o1->inner.flag, false);
+    M_ASSERT_EQ(o1->desc, "outer");
+
+    // 缺失字段、类型不匹配、未知字段与转义的键
+    const auto o2 = Json::Reader::parse<OuterTypeWithOr>(R"( { "value" : 1.5, "desc": 5, "extra": [1, {"a": null}], "inner": 3 } )");
+    M_ASSERT_TRUE(o2.has_value());
+    M_ASSERT_EQ(o2->value, 1.5);
+    M_ASSERT_EQ(o2->desc, "empty");
+    M_ASSERT_EQ(o2->inner.id, 0);
+    M_ASSERT_EQ(o2->inner.name, "default");
+    M_ASSERT_EQ(o2->inner.flag, true);
+
+    const auto o3 = Json::Reader::parse<OuterTypeWithOr>(R"({"value":1.0})");
+    M_ASSERT_EQ(o3->inner.id, 99);
+    M_ASSERT_EQ(o3->inner.name, "json_default");
+    M_ASSERT_EQ(Json::Reader::parse<OuterType>(R"({"v\u0061lue":4.0})")->value, 4.0);
+
+    // 重复的键以第一个为准，与 Json::parse 相同
+    constexpr std::string_view duplicated = R"({"value":1.0,"inner":{"id":1,"id":2},"value":2.0,"v\u0061lue":3.0})";
+    const auto d1 = Json::Reader::parse<OuterType>(duplicated);
+    const OuterType d2{ Json::parse(duplicated).value() };
+    M_ASSERT_EQ(d1->value, 1.0);
+    M_ASSERT_EQ(d1->inner.id, 1);
+    M_ASSERT_EQ(d2.value, d1->value);
+    M_ASSERT_EQ(d2.inner.id, d1->inner.id);
+
+    // 列表直接读取，无法转换的元素使用默认值
+    const auto list = Json::Reader::parse<std::vector<InnerType>>(R"([{"id":1,"name":"A"}, null, {"id":2}])");
+    M_ASSERT_TRUE(list.has_value());
+    M_ASSERT_EQ(list->size(), 3);
+    M_ASSERT_EQ(list->at(0).name, "A");
+    M_ASSERT_EQ(list->at(1).name, "default");
+    M_ASSERT_EQ(list->at(2).id, 2);
+    M_ASSERT_EQ(Json::Reader::parse<std::vector<int>>("[1, 2.6, \"x\"]", 0).value_or(std::vector<int>{}), (std::vector<int>{1, 3, 0}));
+
+    // 错误
+    M_ASSERT_EQ(Json::Reader::parse<OuterType>("  ").error(), json::ParseError::eEmptyData);
+    M_ASSERT_EQ(Json::Reader::parse<OuterType>(R"({"value":1.0)").error(), json::ParseError::eUnclosedObject);
+    M_ASSERT_EQ(Json::Reader::parse<OuterType>(R"({"desc":"a)").error(), json::ParseError::eUnclosedString);
+    M_ASSERT_EQ(Json::Reader::parse<OuterType>(R"({"value" 1})").error(), json::ParseError::eUnknownFormat);
+    M_ASSERT_EQ(Json::Reader::parse<OuterType>(R"({} x)").error(), json::ParseError::eRedundantText);
+    M_ASSERT_EQ(Json::Reader::parse<OuterType>(R"({"inner":{}})", nullptr, 1).error(), json::ParseError::eDepthExceeded);
+}
@@ -0,0 +1,64 @@
+#include <vct/test_unit_macros.hpp>
+
+import std;
+import vct.test.unit;
+import vct.tools.json;
+
+using namespace vct::tools;
+
+namespace {
+    // far deeper than a recursive destructor could handle
+    Json deep_tree(const std::size_t depth) {
+        Json root{ Json::Object{} };
+        Json* node = &root;
+        for (std::size_t i = 0; i < depth; ++i) {
+            if (i % 2) {
+                node->arr().emplace_back(Json::Object{});
+                node = &node->arr().back();
+            } else {
+                node->obj().emplace("next", Json::Array{});
+                node = &node->obj().begin()->second;
+            }
+        }
+        return root;
+    }
+}
+
+M_TEST(Destroy, Deep) {
+    {
+        Json root = deep_tree(1'000'000);
+        M_ASSERT_EQ(root.size(), 1);
+    }
+    Json root = deep_tree(1'000'000);
+    root = 1;   // assignment releases the old tree the same way
+    M_ASSERT_EQ(root.num(), 1);
+    root.reset<Json::Array>();
+    M_ASSERT_TRUE(root.empty());
+}
+
+M_TEST(Destroy, Wide) {
+    // many shallow records, and subtrees just past the recursion depth
+    Json records{ Json::Array{} };
+    for (int i = 0; i < 100'000; ++i) records.arr().emplace_back(Json::Object{ { "id", i }, { "tags", Json::Array{ "a", "b" } } });
+    for (int i = 0; i < 100; ++i) records.arr().push_back(deep_tree(60 + i));
+    M_ASSERT_EQ(records.size(), 100'100);
+    records = nullptr;
+    M_ASSERT_TRUE(records.is_nul());
+}
+
+M_TEST(Destroy, Reclaimer) {
+    Json kept = Json::parse(R"({"a":[1,2,{"b":[3]}]})").value();
+    {
+        Json::Reclaimer reclaimer;
+        Json tree = deep_tree(100'000);
+        reclaimer.release(std::move(tree));
+        M_ASSERT_TRUE(tree.is_nul());
+
+        Json scalar{ "text" };
+        reclaimer.release(std::move(scalar));
+        M_ASSERT_TRUE(scalar.is_nul());
+
+        for (int i = 0; i < 100; ++i) reclaimer.release(Json{ kept });
+    }   // waits for the queue to be drained
+    M_ASSERT_EQ(kept["a"][2]["b"][0].to<int>(), 3);
+}
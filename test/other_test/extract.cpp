@@ -0,0 +1,71 @@
+#include <vct/test_unit_macros.hpp>
+
+import std;
+import vct.test.unit;
+import vct.tools.json;
+
+using namespace vct::tools;
+
+namespace {
+    Json::Extractor make_extractor(const std::initializer_list<std::string_view> texts) {
+        std::vector<Json::Pointer> pointers;
+        for (const auto text : texts) pointers.push_back(*Json::Pointer::parse(text));
+        return Json::Extractor{ pointers };
+    }
+}
+
+M_TEST(Extractor, Raw) {
+    const auto extractor = make_extractor({ "/b/1", "/a", "/missing", "/b", "/c/x~1y" });
+    const std::string_view text = R"( {"a": "s\"tr", "b": [1, {"k": [true]}, 3], "c": {"x/y": null}} )";
+    const auto found = extractor.raw(text);
+    M_ASSERT_TRUE(found.has_value());
+    M_ASSERT_EQ(found->size(), 5);
+    M_ASSERT_EQ(found->at(0).value(), R"({"k": [true]})");
+    M_ASSERT_EQ(found->at(1).value(), R"("s\"tr")");
+    M_ASSERT_FALSE(found->at(2).has_value());
+    M_ASSERT_EQ(found->at(3).value(), R"([1, {"k": [true]}, 3])");
+    M_ASSERT_EQ(found->at(4).value(), "null");
+
+    const auto root = make_extractor({ "" }).raw(" [1, 2] ");
+    M_ASSERT_EQ(root->at(0).value(), "[1, 2]");
+
+    // first value of a duplicated key, same as `Json::parse`
+    const auto duplicate = make_extractor({ "/a" }).raw(R"({"a": 1, "a": 2})");
+    M_ASSERT_EQ(duplicate->at(0).value(), "1");
+
+    // a later duplicate of a parent key is not entered either
+    const std::string_view nested = R"({"a": {"x": 1}, "a": {"y": 2}})";
+    const auto parent = make_extractor({ "/a/y", "/a/x" }).raw(nested);
+    M_ASSERT_FALSE(parent->at(0).has_value());
+    M_ASSERT_EQ(parent->at(1).value(), "1");
+    M_ASSERT_TRUE(Json::parse(nested)->find(*Json::Pointer::parse("/a/y")) == nullptr);
+}
+
+M_TEST(Extractor, Extract) {
+    const auto extractor = make_extractor({ "/list/2", "/name", "/escAped" });
+    const auto values = extractor.extract(R"({"name": "json", "esc\u0041ped": 7, "list": [0, 1, {"deep": [1.5]}]})");
+    M_ASSERT_TRUE(values.has_value());
+    M_ASSERT_EQ(values->at(0)->at("deep")[0].num(), 1.5);
+    M_ASSERT_EQ(values->at(1)->str(), "json");
+    M_ASSERT_EQ(values->at(2)->num(), 7); // escaped keys are compared after unescaping
+}
+
+M_TEST(Extractor, EarlyStop) {
+    const auto extractor = make_extractor({ "/id" });
+    // the text after the found value is not read
+    const auto found = extractor.raw(R"({"id": 42, "rest": [ this is not json)");
+    M_ASSERT_TRUE(found.has_value());
+    M_ASSERT_EQ(found->at(0).value(), "42");
+}
+
+M_TEST(Extractor, Errors) {
+    const auto extractor = make_extractor({ "/missing" });
+    M_ASSERT_EQ(extractor.raw("").error(), json::ParseError::eEmptyData);
+    M_ASSERT_EQ(extractor.raw(R"({"a": [1, 2})").error(), json::ParseError::eUnknownFormat);
+    M_ASSERT_EQ(extractor.raw(R"({"a": "x)").error(), json::ParseError::eUnclosedString);
+    M_ASSERT_EQ(extractor.raw(R"({"a": "\q"})").error(), json::ParseError::eIllegalEscape);
+    M_ASSERT_EQ(extractor.raw(R"({"a": tru})").error(), json::ParseError::eUnknownFormat);
+    M_ASSERT_EQ(extractor.raw(R"({"a": 1} x)").error(), json::ParseError::eRedundantText);
+    M_ASSERT_EQ(extractor.raw(R"([[[1]]])", 1).error(), json::ParseError::eDepthExceeded);
+    M_ASSERT_TRUE(extractor.raw(R"({"a": [1, {"b": "é"}], "c": null})").has_value());
+}
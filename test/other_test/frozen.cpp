@@ -0,0 +1,89 @@
+#include <vct/test_unit_macros.hpp>
+
+import std;
+import vct.test.unit;
+import vct.tools.json;
+
+using namespace vct::tools;
+
+M_TEST(Frozen, Read) {
+    const Json json = Json::parse(R"({"name":"flags","on":true,"rate":0.5,"list":[1,"a",null,{"x":[]}],"empty":{}})").value();
+    const Json::Frozen frozen = json.freeze();
+    const auto root = frozen.root();
+
+    M_ASSERT_TRUE(root.is_obj());
+    M_ASSERT_EQ(root.size(), 5);
+    M_ASSERT_EQ(root.at("name").str(), "flags");
+    M_ASSERT_TRUE(root.at("on").bol());
+    M_ASSERT_EQ(root.at("rate").num(), 0.5);
+    M_ASSERT_FALSE(root.find("missing").has_value());
+    M_ASSERT_THROW(std::ignore = root.at("missing"), std::out_of_range);
+    M_ASSERT_THROW(std::ignore = root.at("name").num(), std::bad_variant_access);
+
+    const auto list = root.at("list");
+    M_ASSERT_EQ(list.size(), 4);
+    M_ASSERT_EQ(list.at(0).num(), 1);
+    M_ASSERT_EQ(list.at(1).str(), "a");
+    M_ASSERT_TRUE(list.at(2).is_nul());
+    M_ASSERT_EQ(list.at(3).at("x").size(), 0);
+    M_ASSERT_THROW(std::ignore = list.at(4), std::out_of_range);
+    M_ASSERT_THROW(std::ignore = list.key(0), std::out_of_range);
+    M_ASSERT_FALSE(list.find("x").has_value());
+
+    std::set<std::string> keys;
+    for (std::size_t i = 0; i < root.size(); ++i) keys.emplace(root.key(i));
+    M_ASSERT_EQ(keys.size(), 5);
+    M_ASSERT_TRUE(keys.contains("empty"));
+
+    M_ASSERT_TRUE(root.to_json() == json);
+    M_ASSERT_TRUE(Json::Frozen{}.root().is_nul());
+}
+
+M_TEST(Frozen, Nested) {
+    // objects inside objects, each object's slots must stay apart from its children's
+    const Json json = Json::parse(R"({
+        "z": {"b": {"k": 1, "j": [true, {"q": "deep"}]}, "a": 2, "c": {}},
+        "m": [{"y": 3, "x": {"w": 4}}],
+        "a": {"only": null}
+    })").value();
+    const auto frozen = json.freeze();
+    const auto root = frozen.root();
+    M_ASSERT_EQ(root.size(), 3);
+    M_ASSERT_EQ(root.at("z").size(), 3);
+    M_ASSERT_EQ(root.at("z").at("a").num(), 2);
+    M_ASSERT_EQ(root.at("z").at("b").at("k").num(), 1);
+    M_ASSERT_EQ(root.at("z").at("b").at("j").at(1).at("q").str(), "deep");
+    M_ASSERT_EQ(root.at("z").at("c").size(), 0);
+    M_ASSERT_EQ(root.at("m").at(0).at("x").at("w").num(), 4);
+    M_ASSERT_EQ(root.at("m").at(0).at("y").num(), 3);
+    M_ASSERT_TRUE(root.at("a").at("only").is_nul());
+    M_ASSERT_FALSE(root.at("z").find("k").has_value());
+    M_ASSERT_TRUE(root.to_json() == json);
+}
+
+M_TEST(Frozen, Snapshot) {
+    Json::Snapshot flags{ Json::parse(R"({"version":0})")->freeze() };
+    std::atomic<bool> stop{ false };
+    std::atomic<bool> ordered{ true };
+    std::vector<std::jthread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            double last = 0;
+            while (!stop) {
+                const auto snapshot = flags.load();
+                const double version = snapshot->root().at("version").num();
+                if (version < last) ordered = false;
+                last = version;
+            }
+        });
+    }
+    for (int version = 1; version <= 200; ++version) {
+        Json json{ Json::Object{} };
+        json["version"] = version;
+        flags.store(json.freeze());
+    }
+    stop = true;
+    readers.clear();
+    M_ASSERT_TRUE(ordered.load());
+    M_ASSERT_EQ(flags.load()->root().at("version").num(), 200);
+}
@@ -144,3 +144,28 @@ M_TEST(Value, Move) {
     auto opt_wrong = v_wrong.move_if<Json::Array>();
     M_ASSERT_FALSE(opt_wrong.has_value());
 }
+
+M_TEST(Value, MoveSemantics) {
+    static_assert(std::is_nothrow_move_constructible_v<Json>);
+    static_assert(std::is_nothrow_move_assignable_v<Json>);
+
+    Json source{Json::Array{{1, "two", Json::Object{{"three", 3}}}}};
+    const auto* data = source.arr().data();
+    Json target{std::move(source)};
+    M_ASSERT_TRUE(source.is_nul());
+    M_ASSERT_TRUE(target.arr().data() == data); // the buffer is taken over, not copied
+
+    Json assigned{"old"};
+    assigned = std::move(target);
+    M_ASSERT_TRUE(target.is_nul());
+    M_ASSERT_TRUE(assigned.arr().data() == data);
+    assigned = std::move(assigned);
+    M_ASSERT_EQ(assigned.size(), 3);
+
+    // growth moves the elements, strings keep their buffers
+    Json::Array array;
+    array.emplace_back(Json::String(100, 'x'));
+    const char* chars = array[0].str().data();
+    array.reserve(array.capacity() + 16);
+    M_ASSERT_TRUE(array[0].str().data() == chars);
+}
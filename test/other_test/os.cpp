@@ -138,3 +138,26 @@ M_TEST(OS, ordered_many_complex) {
 
 
 
+
+M_TEST(OS, stream_write) {
+    const std::string pretty_str = read_file("files/many_complex.json");
+    const Json value = Json::parse(pretty_str).value_or( nullptr );
+    M_ASSERT_NE( value.type(), json::Type::eNull );
+
+    // Stream output is larger than the internal buffer and must equal string output
+    std::ostringstream plain_os;
+    value.write(plain_os);
+    M_ASSERT_TRUE( plain_os.good() );
+    M_EXPECT_EQ( plain_os.str(), value.dump() );
+
+    std::ostringstream pretty_os;
+    M_ASSERT_TRUE( value.writef(pretty_os, 4) );
+    M_EXPECT_EQ( pretty_os.str(), value.dumpf(4).value_or("") );
+
+    // Failed streams are not written to
+    std::ostringstream failed_os;
+    failed_os.setstate(std::ios::failbit);
+    value.write(failed_os);
+    M_ASSERT_FALSE( value.writef(failed_os) );
+    M_ASSERT_TRUE( failed_os.str().empty() );
+}
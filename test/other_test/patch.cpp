@@ -0,0 +1,70 @@
+#include <vct/test_unit_macros.hpp>
+
+import std;
+import vct.test.unit;
+import vct.tools.json;
+
+using namespace vct::tools;
+
+M_TEST(Patch, Apply) {
+    // examples from RFC 6902, appendix A
+    auto json = Json::parse(R"({"foo": ["bar", "baz"], "qux": {"baz": 1, "bar": 2}})").value();
+    M_ASSERT_TRUE(json.apply_patch(Json::parse(R"([
+        {"op": "add", "path": "/foo/1", "value": "qux"},
+        {"op": "remove", "path": "/qux/bar"},
+        {"op": "replace", "path": "/qux/baz", "value": "boo"},
+        {"op": "move", "from": "/foo/0", "path": "/first"},
+        {"op": "copy", "from": "/qux", "path": "/foo/-"},
+        {"op": "test", "path": "/foo/0", "value": "qux"}
+    ])").value()));
+    M_ASSERT_TRUE(json == Json::parse(R"({"foo": ["qux", "baz", {"baz": "boo"}], "qux": {"baz": "boo"}, "first": "bar"})").value());
+
+    M_ASSERT_TRUE(json.apply_patch(Json::parse(R"([{"op": "move", "from": "/qux", "path": "/first"}])").value()));
+    M_ASSERT_EQ(json["first"]["baz"].str(), "boo");
+    M_ASSERT_FALSE(json.contains("qux"));
+
+    M_ASSERT_TRUE(json.apply_patch(Json::parse(R"([{"op": "replace", "path": "", "value": [1]}])").value()));
+    M_ASSERT_TRUE(json == Json::parse("[1]").value());
+}
+
+M_TEST(Patch, Rollback) {
+    const auto original = Json::parse(R"({"a": [1, 2, 3], "b": {"c": true}, "d": "x"})").value();
+    const auto failed = [&original](const std::string_view patch) {
+        auto json = original;
+        const bool ok = json.apply_patch(Json::parse(patch).value());
+        return !ok && json == original;
+    };
+    // each patch changes the document before the failing operation
+    M_ASSERT_TRUE(failed(R"([{"op": "add", "path": "/a/0", "value": 0}, {"op": "remove", "path": "/b/x"}])"));
+    M_ASSERT_TRUE(failed(R"([{"op": "add", "path": "/d", "value": 1}, {"op": "test", "path": "/d", "value": "x"}])"));
+    M_ASSERT_TRUE(failed(R"([{"op": "remove", "path": "/a/1"}, {"op": "replace", "path": "/a/5", "value": 0}])"));
+    M_ASSERT_TRUE(failed(R"([{"op": "move", "from": "/a/0", "path": "/a/2"}, {"op": "move", "from": "/b", "path": "/d"}, {"op": "copy", "from": "/z", "path": "/y"}])"));
+    M_ASSERT_TRUE(failed(R"([{"op": "replace", "path": "", "value": null}, {"op": "bad", "path": ""}])"));
+    M_ASSERT_TRUE(failed(R"([{"op": "move", "from": "/b", "path": "/b/c/d"}])"));
+    M_ASSERT_TRUE(failed(R"([{"op": "add", "path": "/a/4", "value": 0}])"));
+    M_ASSERT_TRUE(failed(R"([{"op": "add", "path": "/a/-"}])"));
+    M_ASSERT_TRUE(failed(R"({"op": "remove", "path": "/d"})"));
+}
+
+M_TEST(Patch, Diff) {
+    const auto source = Json::parse(R"({"same": {"deep": [1, 2]}, "list": [1, 2, 3], "gone": 0, "kind": "a", "obj": {"x": 1}})").value();
+    const auto target = Json::parse(R"({"same": {"deep": [1, 2]}, "list": [1, 5], "kind": 1, "obj": {"x": 1, "y": [true]}, "new": null})").value();
+
+    const auto patch = Json::diff(source, target);
+    M_ASSERT_TRUE(patch.is_arr());
+    M_ASSERT_EQ(patch.size(), 6);   // gone, kind, list/1, list/2, obj/y, new
+    auto json = source;
+    M_ASSERT_TRUE(json.apply_patch(patch));
+    M_ASSERT_TRUE(json == target);
+
+    M_ASSERT_EQ(Json::diff(source, source).size(), 0);
+    M_ASSERT_EQ(Json::diff(target, Json::parse(R"({"same": {"deep": [1, 2]}, "list": [1, 5], "kind": 1, "obj": {"x": 1, "y": [true]}, "new": null})").value()).size(), 0);
+
+    const auto root = Json::diff(Json{ 1 }, Json{ "s" });
+    M_ASSERT_EQ(root.size(), 1);
+    M_ASSERT_EQ(root[0]["op"].str(), "replace");
+    M_ASSERT_EQ(root[0]["path"].str(), "");
+
+    const auto escaped = Json::diff(Json::parse(R"({"a/b": {"~": 1}})").value(), Json::parse(R"({"a/b": {"~": 2}})").value());
+    M_ASSERT_EQ(escaped[0]["path"].str(), "/a~1b/~0");
+}
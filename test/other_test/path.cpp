@@ -0,0 +1,96 @@
+#include <vct/test_unit_macros.hpp>
+
+import std;
+import vct.test.unit;
+import vct.tools.json;
+
+using namespace vct::tools;
+
+namespace {
+    // the example document of RFC 9535
+    const Json store = Json::parse(R"({ "store": {
+        "book": [
+            { "category": "reference", "author": "Nigel Rees", "title": "Sayings of the Century", "price": 8.95 },
+            { "category": "fiction", "author": "Evelyn Waugh", "title": "Sword of Honour", "price": 12.99 },
+            { "category": "fiction", "author": "Herman Melville", "title": "Moby Dick", "isbn": "0-553-21311-3", "price": 8.99 },
+            { "category": "fiction", "author": "J. R. R. Tolkien", "title": "The Lord of the Rings", "isbn": "0-395-19395-8", "price": 22.99 }
+        ],
+        "bicycle": { "color": "red", "price": 399 }
+    } })").value();
+
+    std::vector<Json> query(const Json& json, const std::string_view text) {
+        const auto path = Json::Path::parse(text);
+        if (!path) throw std::invalid_argument("invalid path");
+        std::vector<Json> result;
+        for (const Json* node : path->query(json)) result.push_back(*node);
+        return result;
+    }
+}
+
+M_TEST(Path, Selectors) {
+    M_ASSERT_EQ(query(store, "$.store.book[*].author").size(), 4);
+    M_ASSERT_EQ(query(store, "$..author").size(), 4);
+    M_ASSERT_EQ(query(store, "$.store.*").size(), 2);
+    M_ASSERT_EQ(query(store, "$.store..price").size(), 5);
+    M_ASSERT_EQ(query(store, "$..book[2].author").front().str(), "Herman Melville");
+    M_ASSERT_EQ(query(store, "$..book[-1].title").front().str(), "The Lord of the Rings");
+    M_ASSERT_TRUE(query(store, "$..book[4]").empty());
+    M_ASSERT_EQ(query(store, "$..book[0,1]").size(), 2);
+    M_ASSERT_EQ(query(store, "$..book[:2]").size(), 2);
+    M_ASSERT_EQ(query(store, "$['store'][\"bicycle\"]['color']").front().str(), "red");
+    M_ASSERT_EQ(query(store, "$").size(), 1);
+
+    const Json array = Json::parse(R"(["a","b","c","d","e","f","g"])").value();
+    const auto joined = [&array](const std::string_view text) {
+        std::string out;
+        for (const auto& val : query(array, text)) out += val.str();
+        return out;
+    };
+    M_ASSERT_EQ(joined("$[1:3]"), "bc");
+    M_ASSERT_EQ(joined("$[5:]"), "fg");
+    M_ASSERT_EQ(joined("$[1:5:2]"), "bd");
+    M_ASSERT_EQ(joined("$[5:1:-2]"), "fd");
+    M_ASSERT_EQ(joined("$[::-1]"), "gfedcba");
+    M_ASSERT_EQ(joined("$[-2:]"), "fg");
+    M_ASSERT_EQ(joined("$[::0]"), "");
+    M_ASSERT_EQ(joined("$[0, 0]"), "aa");
+}
+
+M_TEST(Path, Filters) {
+    M_ASSERT_EQ(query(store, "$..book[?@.isbn]").size(), 2);
+    M_ASSERT_EQ(query(store, "$..book[?!@.isbn]").size(), 2);
+    M_ASSERT_EQ(query(store, "$..book[?@.price < 10].title").size(), 2);
+    M_ASSERT_EQ(query(store, "$..book[?@.price<10 && @.category=='fiction'].title").front().str(), "Moby Dick");
+    M_ASSERT_EQ(query(store, "$..book[?@.author == 'Nigel Rees' || @.price > 20]").size(), 2);
+    M_ASSERT_EQ(query(store, "$..book[?!(@.price >= 10)]").size(), 2);
+    M_ASSERT_EQ(query(store, "$..*[?@.price == $.store.bicycle.price]").size(), 1);
+    M_ASSERT_EQ(query(store, "$..book[?@.missing == @.other]").size(), 4); // Nothing == Nothing
+    M_ASSERT_TRUE(query(store, "$..book[?@.title < 1]").empty());          // different types
+
+    const Json values = Json::parse(R"([1, "1", null, true, [1], {"a":1}])").value();
+    M_ASSERT_EQ(query(values, "$[?@ == 1]").size(), 1);
+    M_ASSERT_EQ(query(values, "$[?@ == null]").size(), 1);
+    M_ASSERT_EQ(query(values, "$[?@ == true]").size(), 1);
+    M_ASSERT_EQ(query(values, "$[?@.a]").size(), 1);
+    M_ASSERT_EQ(query(values, "$[?@[0]]").size(), 1);
+}
+
+M_TEST(Path, Parse) {
+    M_ASSERT_TRUE(Json::Path::parse("$.a..b[0]['c',\"d\"][1:2:3][?@.x]").has_value());
+    M_ASSERT_TRUE(Json::Path::parse("$['\\u00e9\\'']").has_value());
+    M_ASSERT_TRUE(Json::Path::parse("$..book[?@.price]")->query(store).size() == 4);
+    M_ASSERT_TRUE(Json::Path::parse("$.a.b")->is_singular());
+    M_ASSERT_FALSE(Json::Path::parse("$.a[*]")->is_singular());
+
+    for (const std::string_view invalid : {
+        "", "a", "$.", "$..", "$[", "$[]", "$[01]", "$[-0]", "$['a'", "$.1", "$ ",
+        "$[?@.a == @.*]", "$[?1]", "$[?length(@) > 1]", "$[?@.a ==]", "$[9007199254740992]"
+    }) {
+        M_ASSERT_FALSE(Json::Path::parse(invalid).has_value());
+    }
+
+    // results refer into the document
+    Json doc = Json::parse(R"({"a":[1,2,3]})").value();
+    for (Json* node : Json::Path::parse("$.a[*]")->query(doc)) node->num() *= 10;
+    M_ASSERT_EQ(doc["a"][2].num(), 30);
+}
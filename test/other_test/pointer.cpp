@@ -0,0 +1,71 @@
+#include <vct/test_unit_macros.hpp>
+
+import std;
+import vct.test.unit;
+import vct.tools.json;
+
+using namespace vct::tools;
+
+M_TEST(Pointer, Parse) {
+    const auto pointer = Json::Pointer::parse("/a~1b/m~0n/0/01/");
+    M_ASSERT_TRUE(pointer.has_value());
+    const auto tokens = pointer->tokens();
+    M_ASSERT_EQ(tokens.size(), 5);
+    M_ASSERT_EQ(tokens[0].key, "a/b");
+    M_ASSERT_EQ(tokens[1].key, "m~n");
+    M_ASSERT_EQ(tokens[2].index, 0);
+    M_ASSERT_EQ(tokens[3].index, std::numeric_limits<std::size_t>::max()); // leading zero is not an index
+    M_ASSERT_EQ(tokens[4].key, "");
+    M_ASSERT_EQ(pointer->to_string(), "/a~1b/m~0n/0/01/");
+    M_ASSERT_TRUE(pointer->parent() == *Json::Pointer::parse("/a~1b/m~0n/0/01"));
+
+    M_ASSERT_TRUE(Json::Pointer::parse("")->empty());
+    M_ASSERT_FALSE(Json::Pointer::parse("a").has_value());
+    M_ASSERT_FALSE(Json::Pointer::parse("/a~2").has_value());
+    M_ASSERT_FALSE(Json::Pointer::parse("/a~").has_value());
+
+    Json::Pointer built;
+    built.push_back("a/b").push_back(3);
+    M_ASSERT_EQ(built.to_string(), "/a~1b/3");
+    M_ASSERT_EQ(built.tokens()[1].index, 3);
+}
+
+M_TEST(Pointer, Evaluate) {
+    // examples of RFC 6901
+    const Json doc = Json::parse(R"({"foo":["bar","baz"],"":0,"a/b":1,"c%d":2,"e^f":3,"g|h":4,"i\\j":5,"k\"l":6," ":7,"m~n":8})").value();
+    const auto at = [&doc](const std::string_view text) -> const Json& { return doc.at(*Json::Pointer::parse(text)); };
+    M_ASSERT_TRUE(at("") == doc);
+    M_ASSERT_EQ(at("/foo").size(), 2);
+    M_ASSERT_EQ(at("/foo/0").str(), "bar");
+    M_ASSERT_EQ(at("/").num(), 0);
+    M_ASSERT_EQ(at("/a~1b").num(), 1);
+    M_ASSERT_EQ(at("/c%d").num(), 2);
+    M_ASSERT_EQ(at("/i\\j").num(), 5);
+    M_ASSERT_EQ(at("/k\"l").num(), 6);
+    M_ASSERT_EQ(at("/ ").num(), 7);
+    M_ASSERT_EQ(at("/m~0n").num(), 8);
+
+    M_ASSERT_TRUE(doc.find(*Json::Pointer::parse("/foo/2")) == nullptr);
+    M_ASSERT_TRUE(doc.find(*Json::Pointer::parse("/foo/-")) == nullptr);
+    M_ASSERT_TRUE(doc.find(*Json::Pointer::parse("/foo/0/x")) == nullptr);
+    M_ASSERT_THROW(std::ignore = at("/missing"), std::out_of_range);
+}
+
+M_TEST(Pointer, Set) {
+    Json doc = Json::parse(R"({"items":[{"price":1}]})").value();
+    const auto price = *Json::Pointer::parse("/items/0/price");
+    M_ASSERT_TRUE(doc.set(price, 2.5));
+    M_ASSERT_EQ(doc.at(price).num(), 2.5);
+
+    M_ASSERT_TRUE(doc.set(*Json::Pointer::parse("/items/-"), "x"));
+    M_ASSERT_TRUE(doc.set(*Json::Pointer::parse("/items/2"), true));
+    M_ASSERT_FALSE(doc.set(*Json::Pointer::parse("/items/5"), 0));
+    M_ASSERT_EQ(doc["items"].size(), 3);
+    M_ASSERT_TRUE(doc.set(*Json::Pointer::parse("/items/0/name"), "first"));
+    M_ASSERT_EQ(doc["items"][0]["name"].str(), "first");
+    M_ASSERT_FALSE(doc.set(*Json::Pointer::parse("/missing/key"), 1));
+    M_ASSERT_FALSE(doc.set(*Json::Pointer::parse("/items/1/key"), 1));
+
+    M_ASSERT_TRUE(doc.set(Json::Pointer{}, nullptr));
+    M_ASSERT_TRUE(doc.is_nul());
+}
@@ -0,0 +1,81 @@
+#include <vct/test_unit_macros.hpp>
+#define M_VCT_TOOLS_JSON_SIMPLIFY_MACROS
+#include <vct/tools/json_macros.hpp>
+import std;
+import vct.test.unit;
+import vct.tools.json;
+
+using namespace vct::tools;
+
+namespace {
+    struct Event {
+        std::string id{};
+        Json::Raw metadata{};
+
+        M_JSON_CV_FUN(Event,
+            M_JSON_CV_MEM(id)
+            M_JSON_CV_MEM(metadata)
+        )
+        M_JSON_CS_FUN(Event,
+            M_JSON_CS_MEM(id)
+            M_JSON_CS_MEM(metadata)
+        )
+    };
+}
+
+M_TEST(Raw, SkipValue) {
+    const std::string_view text = R"(  {"a": ["x\"]", {"b": null}], "c": -1.5e3}  , 1)";
+    auto it = text.begin();
+    M_ASSERT_EQ(Json::skip_value(it, text.end()), json::ParseError::eNone);
+    M_ASSERT_EQ(std::string_view(it, text.end()), "  , 1");
+
+    const auto skip = [](const std::string_view input, const std::int32_t max_depth = 256) {
+        auto pos = input.begin();
+        return Json::skip_value(pos, input.end(), max_depth);
+    };
+    M_ASSERT_EQ(skip("   "), json::ParseError::eEmptyData);
+    M_ASSERT_EQ(skip(R"(["a")"), json::ParseError::eUnclosedArray);
+    M_ASSERT_EQ(skip(R"({"a" 1})"), json::ParseError::eUnknownFormat);
+    M_ASSERT_EQ(skip(R"("\uD800")"), json::ParseError::eIllegalEscape);
+    M_ASSERT_EQ(skip("\"a\nb\""), json::ParseError::eIllegalEscape);
+    M_ASSERT_EQ(skip("nul"), json::ParseError::eUnknownFormat);
+    M_ASSERT_EQ(skip("1.2.3"), json::ParseError::eInvalidNumber);
+    // same depth limit as `Json::parse`
+    M_ASSERT_EQ(skip("[1]", 2), json::ParseError::eNone);
+    M_ASSERT_TRUE(Json::parse("[1]", 2).has_value());
+    M_ASSERT_EQ(skip("[[1]]", 2), json::ParseError::eDepthExceeded);
+    M_ASSERT_EQ(Json::parse("[[1]]", 2).error(), json::ParseError::eDepthExceeded);
+}
+
+M_TEST(Raw, Value) {
+    M_ASSERT_EQ(Json::Raw{}.text(), "null");
+    const auto raw = Json::Raw::from(R"(  {"k": [1, 2]} )");
+    M_ASSERT_TRUE(raw.has_value());
+    M_ASSERT_EQ(raw->text(), R"({"k": [1, 2]})");
+    M_ASSERT_EQ(static_cast<Json>(*raw)["k"][1].num(), 2);
+    M_ASSERT_EQ(Json::Raw::from("[1] 2").error(), json::ParseError::eRedundantText);
+    M_ASSERT_EQ(Json::Raw::from("").error(), json::ParseError::eEmptyData);
+    M_ASSERT_EQ(Json::Raw{ Json::parse(R"({"a": true})").value() }.text(), R"({"a":true})");
+
+    Json::String out;
+    Json::Writer{ out }.begin_array().value(*raw).value(1).end_array();
+    M_ASSERT_EQ(out, R"([{"k": [1, 2]},1])");
+}
+
+M_TEST(Raw, PassThrough) {
+    const auto event = Json::Reader::parse<Event>(R"({"metadata": { "client": ["a", 1.50] }, "skipped": [{}], "id": "e1"})");
+    M_ASSERT_TRUE(event.has_value());
+    M_ASSERT_EQ(event->id, "e1");
+    M_ASSERT_EQ(event->metadata.text(), R"({ "client": ["a", 1.50] })");
+
+    Json::String out;
+    Json::Writer{ out }.value(*event);
+    M_ASSERT_EQ(out, R"({"id":"e1","metadata":{ "client": ["a", 1.50] }})");
+
+    const Json json{ *event };
+    M_ASSERT_EQ(json["metadata"]["client"][1].num(), 1.5);
+    const Event back{ json };
+    M_ASSERT_EQ(back.metadata.text(), R"({"client":["a",1.5]})");
+
+    M_ASSERT_EQ(Json::Reader::parse<Event>(R"({"metadata": [1, }, "id": "e1"})").error(), json::ParseError::eUnknownFormat);
+}
@@ -0,0 +1,108 @@
+#include <vct/test_unit_macros.hpp>
+
+import std;
+import vct.test.unit;
+import vct.tools.json;
+
+using namespace vct::tools;
+
+M_TEST(Records, Layout) {
+    const Json array = Json::parse(R"([{"id":1,"name":"a","ok":true},{"ok":false,"name":"b","id":2},{"id":3,"name":"c","ok":null}])").value_or(nullptr);
+    const auto records = Json::Records::from(array);
+    M_ASSERT_TRUE(records.has_value());
+    M_ASSERT_EQ(records->size(), 3);
+    M_ASSERT_EQ(records->width(), 3);
+    M_ASSERT_EQ(records->keys().size(), 3);
+
+    const auto name = records->slot("name");
+    M_ASSERT_TRUE(name.has_value());
+    M_ASSERT_FALSE(records->slot("missing").has_value());
+    M_ASSERT_EQ(records->at(1, *name).str(), "b");
+    M_ASSERT_EQ(records->find(2, "id")->to<int>(), 3);
+    M_ASSERT_TRUE(records->find(3, "id") == nullptr);
+    M_ASSERT_TRUE(records->find(0, "missing") == nullptr);
+    M_ASSERT_THROW(std::ignore = records->at(3, 0), std::out_of_range);
+    M_ASSERT_EQ(records->row(0).size(), 3);
+
+    // column iteration
+    std::string names;
+    for (const Json& value : records->column(*name)) names += value.str();
+    M_ASSERT_EQ(names, "abc");
+    const auto id = *records->slot("id");
+    M_ASSERT_EQ(std::ranges::distance(records->column(id)), 3);
+
+    // round trip
+    M_ASSERT_TRUE(records->to_json() == array);
+    Json moved_array = array;
+    auto moved = Json::Records::from(std::move(moved_array));
+    M_ASSERT_TRUE(moved.has_value());
+    M_ASSERT_TRUE(moved_array.is_arr() && moved_array.arr().empty());
+    M_ASSERT_TRUE(std::move(*moved).to_json() == array);
+
+    // empty array
+    const auto empty = Json::Records::from(Json{ Json::Array{} });
+    M_ASSERT_TRUE(empty.has_value());
+    M_ASSERT_EQ(empty->size(), 0);
+    M_ASSERT_TRUE(empty->to_json() == Json{ Json::Array{} });
+}
+
+M_TEST(Records, Mismatch) {
+    M_ASSERT_FALSE(Json::Records::from(Json{ 1 }).has_value());
+    M_ASSERT_FALSE(Json::Records::from(Json::parse(R"([1, 2])").value_or(nullptr)).has_value());
+    M_ASSERT_FALSE(Json::Records::from(Json::parse(R"([{"a":1},{"b":1}])").value_or(nullptr)).has_value());
+    M_ASSERT_FALSE(Json::Records::from(Json::parse(R"([{"a":1},{"a":1,"b":2}])").value_or(nullptr)).has_value());
+    M_ASSERT_FALSE(Json::Records::from(Json::parse(R"([{"a":1},[]])").value_or(nullptr)).has_value());
+
+    // a failed move leaves the array untouched
+    const auto original = Json::parse(R"([{"a":"x","b":[1]},{"a":"y","b":[2]},{"a":"z"}])").value_or(nullptr);
+    Json source = original;
+    M_ASSERT_FALSE(Json::Records::from(std::move(source)).has_value());
+    M_ASSERT_TRUE(source == original);
+}
+
+M_TEST(Records, Parse) {
+    const std::string_view text = R"( [{"id":1,"name":"a","ok":true}, {"ok":false,"name":"b","id":2}, {"id":3,"name":"c","ok":null,"id":4}] )";
+    const auto records = Json::Records::parse(text);
+    M_ASSERT_TRUE(records.has_value());
+    M_ASSERT_EQ(records->size(), 3);
+    M_ASSERT_EQ(records->width(), 3);
+    // slots follow the key order of the first record
+    M_ASSERT_EQ(records->keys()[0], "id");
+    M_ASSERT_EQ(records->keys()[1], "name");
+    M_ASSERT_EQ(records->at(1, 1).str(), "b");
+    M_ASSERT_EQ(records->find(2, "name")->str(), "c");
+    // a duplicated key keeps its first value, same as `Json::parse`
+    M_ASSERT_EQ(records->find(2, "id")->to<int>(), 3);
+    M_ASSERT_TRUE(records->to_json() == Json::parse(text).value());
+
+    M_ASSERT_EQ(Json::Records::parse("[]")->size(), 0);
+    M_ASSERT_EQ(Json::Records::parse("[{}, {}]")->size(), 2);
+
+    std::ifstream ifs(CURRENT_PATH "/files/many_complex.json", std::ios::binary);
+    const std::string file{ std::istreambuf_iterator<char>{ ifs }, std::istreambuf_iterator<char>{} };
+    const Json parsed = Json::parse(file).value_or(nullptr);
+    const Json& performances = parsed["performances"];
+    const auto direct = Json::Records::parse(*performances.dumpf());
+    M_ASSERT_TRUE(direct.has_value());
+    M_ASSERT_EQ(direct->size(), performances.size());
+    M_ASSERT_TRUE(direct->to_json() == performances);
+}
+
+M_TEST(Records, ParseErrors) {
+    M_ASSERT_EQ(Json::Records::parse(" ").error(), json::ParseError::eEmptyData);
+    M_ASSERT_EQ(Json::Records::parse(R"({"a":1})").error(), json::ParseError::eUnknownFormat);
+    M_ASSERT_EQ(Json::Records::parse(R"([1])").error(), json::ParseError::eUnknownFormat);
+    M_ASSERT_EQ(Json::Records::parse(R"([{"a":1},{"b":1}])").error(), json::ParseError::eUnknownFormat);
+    M_ASSERT_EQ(Json::Records::parse(R"([{"a":1,"b":2},{"a":1}])").error(), json::ParseError::eUnknownFormat);
+    M_ASSERT_EQ(Json::Records::parse(R"([{"a":1},{"a":1,"b":2}])").error(), json::ParseError::eUnknownFormat);
+    M_ASSERT_EQ(Json::Records::parse(R"([{"a":1})").error(), json::ParseError::eUnclosedArray);
+    M_ASSERT_EQ(Json::Records::parse(R"([{"a":1)").error(), json::ParseError::eUnclosedObject);
+    M_ASSERT_EQ(Json::Records::parse(R"([{"a":"\q"}])").error(), json::ParseError::eIllegalEscape);
+    M_ASSERT_EQ(Json::Records::parse(R"([{"a":1}] x)").error(), json::ParseError::eRedundantText);
+    // same depth rule as `Json::parse`
+    M_ASSERT_EQ(Json::Records::parse(R"([{"a":1}])", 2).error(), json::ParseError::eDepthExceeded);
+    M_ASSERT_EQ(Json::parse(R"([{"a":1}])", 2).error(), json::ParseError::eDepthExceeded);
+    M_ASSERT_TRUE(Json::Records::parse(R"([{"a":1}])", 3).has_value());
+    M_ASSERT_TRUE(Json::parse(R"([{"a":1}])", 3).has_value());
+    M_ASSERT_EQ(Json::Records::parse(R"([{"a":[1]}])", 3).error(), json::ParseError::eDepthExceeded);
+}
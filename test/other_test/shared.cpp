@@ -0,0 +1,49 @@
+#include <vct/test_unit_macros.hpp>
+
+import std;
+import vct.test.unit;
+import vct.tools.json;
+
+using namespace vct::tools;
+
+M_TEST(Shared, CopyOnWrite) {
+    Json::Shared config{ Json::parse(R"({"name":"app","workers":[1,2,3]})").value() };
+    M_ASSERT_EQ(config.use_count(), 1);
+
+    std::vector<Json::Shared> handles(100, config);
+    M_ASSERT_EQ(config.use_count(), 101);
+    M_ASSERT_TRUE(&handles[42].get() == &config.get()); // no copy
+    M_ASSERT_EQ(handles[42]->at("name").str(), "app");
+    M_ASSERT_EQ((*handles[0])["workers"].size(), 3);
+
+    // mutation of a shared document clones it first
+    handles[0].mutate()["name"] = "changed";
+    M_ASSERT_EQ(handles[0]->at("name").str(), "changed");
+    M_ASSERT_EQ(config->at("name").str(), "app");
+    M_ASSERT_EQ(handles[0].use_count(), 1);
+    M_ASSERT_EQ(config.use_count(), 100);
+
+    // a sole owner is mutated in place
+    const Json* address = &handles[0].get();
+    handles[0].mutate()["workers"].arr().emplace_back(4);
+    M_ASSERT_TRUE(&handles[0].get() == address);
+    M_ASSERT_EQ(handles[0]->at("workers").size(), 4);
+
+    M_ASSERT_TRUE(Json::Shared{}->is_nul());
+}
+
+M_TEST(Shared, Threads) {
+    const Json::Shared config{ Json::parse(R"({"limit":10})").value() };
+    std::vector<std::jthread> threads;
+    std::atomic<int> sum{};
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&sum, handle = config] {
+            for (int j = 0; j < 1000; ++j) {
+                const Json::Shared local = handle;
+                sum += local->at("limit").to<int>();
+            }
+        });
+    }
+    threads.clear();
+    M_ASSERT_EQ(sum.load(), 80000);
+}
@@ -0,0 +1,67 @@
+#include <vct/test_unit_macros.hpp>
+
+import std;
+import vct.test.unit;
+import vct.tools.json;
+
+using namespace vct::tools;
+
+M_TEST(Tape, Read) {
+    constexpr std::string_view text = R"( {"name":"a\nb","on":false,"list":[1.5,[],{"x":null}],"n":-2} )";
+    const auto tape = Json::Tape::parse(text);
+    M_ASSERT_TRUE(tape.has_value());
+    const auto root = tape->root();
+
+    M_ASSERT_TRUE(root.is_obj());
+    M_ASSERT_EQ(root.size(), 4);
+    M_ASSERT_EQ(root.at("name").str(), "a\nb");
+    M_ASSERT_FALSE(root.at("on").bol());
+    M_ASSERT_EQ(root.at("n").num(), -2);
+    M_ASSERT_FALSE(root.find("missing").has_value());
+    M_ASSERT_THROW(std::ignore = root.at("missing"), std::out_of_range);
+    M_ASSERT_THROW(std::ignore = root.at("on").str(), std::bad_variant_access);
+
+    const auto list = root.at("list");
+    M_ASSERT_EQ(list.size(), 3);
+    M_ASSERT_EQ(list.at(0).num(), 1.5);
+    M_ASSERT_TRUE(list.at(1).is_arr());
+    M_ASSERT_EQ(list.at(1).size(), 0);
+    M_ASSERT_TRUE(list.at(2).at("x").is_nul());
+    M_ASSERT_THROW(std::ignore = list.at(3), std::out_of_range);
+    M_ASSERT_EQ(root.key(2), "list");
+
+    // the same document as the DOM parser, in both directions
+    const Json json = Json::parse(text).value();
+    M_ASSERT_TRUE(tape->to_json() == json);
+    const Json::Tape converted{ json };
+    M_ASSERT_TRUE(converted.to_json() == json);
+    M_ASSERT_EQ(converted.words().size(), tape->words().size());
+    M_ASSERT_TRUE(Json::Tape{}.root().is_nul());
+}
+
+M_TEST(Tape, Errors) {
+    M_ASSERT_EQ(Json::Tape::parse(" ").error(), json::ParseError::eEmptyData);
+    M_ASSERT_EQ(Json::Tape::parse("[1, 2").error(), json::ParseError::eUnclosedArray);
+    M_ASSERT_EQ(Json::Tape::parse(R"({"a":1)").error(), json::ParseError::eUnclosedObject);
+    M_ASSERT_EQ(Json::Tape::parse(R"(["abc)").error(), json::ParseError::eUnclosedString);
+    M_ASSERT_EQ(Json::Tape::parse(R"(["\x"])").error(), json::ParseError::eIllegalEscape);
+    M_ASSERT_EQ(Json::Tape::parse("[tru]").error(), json::ParseError::eUnknownFormat);
+    M_ASSERT_EQ(Json::Tape::parse("{1:2}").error(), json::ParseError::eUnknownFormat);
+    M_ASSERT_EQ(Json::Tape::parse("[1] 2").error(), json::ParseError::eRedundantText);
+    M_ASSERT_EQ(Json::Tape::parse("[[[1]]]", 1).error(), json::ParseError::eDepthExceeded);
+    M_ASSERT_EQ(Json::Tape::parse("[1]", 1).error(), json::ParseError::eDepthExceeded);
+    M_ASSERT_EQ(Json::parse("[1]", 1).error(), json::ParseError::eDepthExceeded);
+    M_ASSERT_TRUE(Json::Tape::parse("[1]", 2).has_value());
+    M_ASSERT_TRUE(Json::parse("[1]", 2).has_value());
+    M_ASSERT_TRUE(Json::Tape::parse("1", 1).has_value());
+
+    std::ifstream ifs(CURRENT_PATH "/files/many_number.json", std::ios::binary);
+    const std::string text{ std::istreambuf_iterator<char>{ ifs }, std::istreambuf_iterator<char>{} };
+    const auto tape = Json::Tape::parse(text);
+    M_ASSERT_TRUE(tape.has_value());
+    M_ASSERT_TRUE(tape->to_json() == Json::parse(text).value());
+
+    const auto escaped = Json::Tape::parse(R"({"k\u00e9y":["a\"b\n",[],{},1e3,"\ud83d\ude00"]})");
+    M_ASSERT_TRUE(escaped.has_value());
+    M_ASSERT_TRUE(escaped->to_json() == Json::parse(R"({"k\u00e9y":["a\"b\n",[],{},1e3,"\ud83d\ude00"]})").value());
+}
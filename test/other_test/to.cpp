@@ -184,3 +184,41 @@ M_TEST(Value, To) {
     M_ASSERT_EQ(v_obj.to_or<Json::String>("default"), "default");
     M_ASSERT_FALSE(v_obj.to_if<Json::String>().has_value());
 }
+
+M_TEST(Value, As) {
+    const Json v_str{"hello"};
+    M_ASSERT_EQ(v_str.as_if<std::string_view>().value(), "hello");
+    M_ASSERT_TRUE(v_str.as_if<std::string_view>()->data() == v_str.str().data()); // no copy
+    M_ASSERT_FALSE(v_str.as_if<std::span<const Json>>().has_value());
+
+    const Json v_arr{Json::Array{{1, 2.6, "x", 4}}};
+    const auto span = v_arr.as_if<std::span<const Json>>();
+    M_ASSERT_TRUE(span.has_value());
+    M_ASSERT_EQ(span->size(), 4);
+    M_ASSERT_TRUE(span->data() == v_arr.arr().data());
+    M_ASSERT_FALSE(v_arr.as_if<std::string_view>().has_value());
+
+    std::vector<int> ints;
+    for (const int i : v_arr.as_range<int>(-1)) ints.push_back(i);
+    M_ASSERT_TRUE(ints == (std::vector<int>{1, 3, -1, 4}));
+    M_ASSERT_EQ(std::ranges::distance(v_arr.as_range<double>()), 4);
+    M_ASSERT_EQ(v_arr.as_range<double>()[1], 2.6);
+    M_ASSERT_TRUE(std::ranges::empty(v_str.as_range<int>()));
+}
+
+M_TEST(Value, ToNumbers) {
+    const Json numbers{Json::Array{{1.4, 2.6, -3.5, 4}}};
+    M_ASSERT_TRUE(numbers.to<std::vector<int>>(0) == (std::vector<int>{1, 3, -4, 4}));
+    M_ASSERT_TRUE(numbers.to<std::vector<float>>(0.0f) == (std::vector<float>{1.4f, 2.6f, -3.5f, 4.0f}));
+    M_ASSERT_TRUE(numbers.to<std::deque<long long>>(0) == (std::deque<long long>{1, 3, -4, 4}));
+    M_ASSERT_TRUE(numbers.to<std::vector<MyEnum>>(MyEnum::C)[3] == static_cast<MyEnum>(4));
+    const Json fractions{Json::Array{{0.3, 0, -0.2}}};
+    M_ASSERT_TRUE(fractions.to<std::vector<bool>>(false) == (std::vector<bool>{true, false, true}));
+    M_ASSERT_EQ(fractions[0].to<bool>(), true);
+
+    // other element types use the per-element conversion
+    const Json mixed{Json::Array{{1, true, "x"}}};
+    M_ASSERT_TRUE(mixed.to<std::vector<int>>(-1) == (std::vector<int>{1, 1, -1}));
+    Json movable = numbers;
+    M_ASSERT_TRUE(movable.move<std::vector<double>>(0.0) == (std::vector<double>{1.4, 2.6, -3.5, 4}));
+}
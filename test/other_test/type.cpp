@@ -33,9 +33,9 @@ M_TEST(Type, enum) {
 // Test the Object type
 M_TEST(Type, Object) {
 
-    M_ASSERT_TRUE( (std::is_same_v<Json::Object, std::map<Json::String, Json>>) );
-    M_ASSERT_EQ( Json::Object{}, (std::map<Json::String, Json> {} ));
-    M_ASSERT_EQ( Json::Object(), (std::map<Json::String, Json> {} ));
+    M_ASSERT_TRUE( (std::is_same_v<Json::Object, std::map<Json::String, Json, std::less<>>>) );
+    M_ASSERT_EQ( Json::Object{}, (std::map<Json::String, Json, std::less<>> {} ));
+    M_ASSERT_EQ( Json::Object(), (std::map<Json::String, Json, std::less<>> {} ));
 }
 
 // Test the Number type
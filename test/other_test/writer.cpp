@@ -0,0 +1,102 @@
+#include <vct/test_unit_macros.hpp>
+
+import std;
+import vct.test.unit;
+import vct.tools.json;
+
+using namespace vct::tools;
+
+enum class Color { eRed = 1, eBlue = 2 };
+
+M_TEST(Writer, String) {
+    Json::String out;
+    {
+        Json::Writer writer{ out };
+        writer.begin_object()
+            .key("id").value(42)
+            .key("name").value("line\n\"quoted\"")
+            .key("ok").value(true)
+            .key("none").null()
+            .key("color").value(Color::eBlue)
+            .key("tags").begin_array().value("a").value(std::string{"b"}).begin_array().end_array().end_array()
+            .key("empty").begin_object().end_object()
+            .key("json").value(Json::parse(R"({"x":[1,2]})").value_or(nullptr))
+            .key("vector").value(std::vector<int>{ 1, 2, 3 })
+        .end_object();
+    }
+    M_ASSERT_EQ(out, R"({"id":42,"name":"line\n\"quoted\"","ok":true,"none":null,"color":2,"tags":["a","b",[]],"empty":{},"json":{"x":[1,2]},"vector":[1,2,3]})");
+
+    const Json parsed = Json::parse(out).value_or(nullptr);
+    M_ASSERT_TRUE(parsed.is_obj());
+    M_ASSERT_EQ(parsed["name"].str(), "line\n\"quoted\"");
+    M_ASSERT_EQ(parsed["tags"].size(), 3);
+
+    // Appends to the existing string, top-level scalars
+    Json::String scalar = "x=";
+    Json::Writer{ scalar }.value(1.5);
+    M_ASSERT_EQ(scalar, "x=1.5");
+}
+
+M_TEST(Writer, Stream) {
+    constexpr int rows = 20000;
+    Json expected{ Json::Array{} };
+
+    std::ostringstream os;
+    {
+        Json::Writer writer{ os };
+        writer.begin_array();
+        for (int i = 0; i < rows; ++i) {
+            writer.begin_object().key("row").value(i).key("text").value("\t").end_object();
+            expected.push_back(Json::Object{ { "row", i }, { "text", "\t" } });
+        }
+        writer.end_array();
+    }
+    M_ASSERT_EQ(os.str(), expected.dump());
+}
+
+M_TEST(Writer, Sink) {
+    std::string collected;
+    std::size_t calls = 0;
+    {
+        Json::Writer writer{ [&](const std::string_view text) { collected.append(text); ++calls; } };
+        writer.begin_array();
+        for (int i = 0; i < 10000; ++i) writer.value("0123456789");
+        writer.end_array();
+        M_ASSERT_TRUE(calls > 0);
+        writer.flush();
+        const auto flushed = calls;
+        writer.flush();
+        M_ASSERT_EQ(calls, flushed);
+    }
+    const Json parsed = Json::parse(collected).value_or(nullptr);
+    M_ASSERT_TRUE(parsed.is_arr());
+    M_ASSERT_EQ(parsed.size(), 10000);
+    // Block writes, not one call per value
+    M_ASSERT_TRUE(calls < 20);
+}
+
+#ifndef NDEBUG
+M_TEST(Writer, Nesting) {
+    Json::String out;
+    Json::Writer writer{ out };
+    M_ASSERT_THROW(writer.key("k"), std::logic_error);
+    M_ASSERT_THROW(writer.end_object(), std::logic_error);
+    writer.begin_object();
+    M_ASSERT_THROW(writer.value(1), std::logic_error);
+    M_ASSERT_THROW(writer.end_array(), std::logic_error);
+    writer.key("k");
+    M_ASSERT_THROW(writer.key("k2"), std::logic_error);
+    M_ASSERT_THROW(writer.end_object(), std::logic_error);
+    writer.value(1).end_object();
+    M_ASSERT_EQ(out, R"({"k":1})");
+    M_ASSERT_THROW(writer.value(2), std::logic_error);
+    M_ASSERT_THROW(writer.begin_array(), std::logic_error);
+    M_ASSERT_EQ(out, R"({"k":1})");
+
+    Json::String scalar;
+    Json::Writer root{ scalar };
+    root.value(1);
+    M_ASSERT_THROW(root.value(2), std::logic_error);
+    M_ASSERT_EQ(scalar, "1");
+}
+#endif
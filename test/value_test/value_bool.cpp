@@ -39,6 +39,13 @@ M_TEST(Value, Bool) {
     M_ASSERT_EQ(implicit_true.to<Json::Bool>(), true);
     M_ASSERT_EQ(implicit_false.to<Json::Bool>(), false);
 
+    // Construction and assignment from lvalues keep the Bool type
+    const bool const_flag = true;
+    Json from_lvalue{ const_flag };
+    M_ASSERT_EQ(from_lvalue.type(), json::Type::eBool);
+    from_lvalue = const_flag;
+    M_ASSERT_EQ(from_lvalue.dump(), "true");
+
     // --- Type checking ---
     Json true_val{true};
     Json false_val{false};
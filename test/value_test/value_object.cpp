@@ -201,6 +201,44 @@ M_TEST(Value, Object) {
     M_ASSERT_TRUE(contains_test.obj().contains("key1"));
     M_ASSERT_FALSE(contains_test.obj().contains("nonexistent"));
 
+    // --- Find Method ---
+    const std::string_view find_key = "key2_suffix";
+    M_ASSERT_TRUE(contains_test.find(find_key.substr(0, 4)) != nullptr);
+    M_ASSERT_EQ(contains_test.find(find_key.substr(0, 4))->str(), "hello");
+    M_ASSERT_TRUE(contains_test.find("nonexistent") == nullptr);
+    M_ASSERT_TRUE(Json{42}.find("key1") == nullptr);
+    const Json& const_find = contains_test;
+    M_ASSERT_EQ(const_find.find("key1")->to<int>(), 1);
+    contains_test.find("key1")->num() = 2;
+    M_ASSERT_EQ(contains_test["key1"].to<int>(), 2);
+    // string_view keys for every accessor
+    Json view_test{Json::Object{}};
+    view_test[find_key.substr(0, 4)] = 1;
+    M_ASSERT_EQ(view_test["key2"].to<int>(), 1);
+    M_ASSERT_EQ(view_test.at(find_key.substr(0, 4)).to<int>(), 1);
+    M_ASSERT_EQ(std::as_const(view_test)[find_key.substr(0, 4)].to<int>(), 1);
+    M_ASSERT_THROW(std::ignore = view_test.at(find_key), std::out_of_range);
+    M_ASSERT_THROW(std::ignore = std::as_const(view_test)[find_key], std::out_of_range);
+    M_ASSERT_TRUE(view_test.contains(find_key.substr(0, 4)));
+    M_ASSERT_TRUE(view_test.insert(find_key, 2));
+    M_ASSERT_EQ(view_test[std::string{ find_key }].to<int>(), 2);
+    M_ASSERT_TRUE(view_test.erase(find_key));
+    M_ASSERT_FALSE(view_test.erase(find_key));
+    M_ASSERT_EQ(view_test.size(), 1);
+
+    json::Json<false> unordered_find{ json::Json<false>::Object{{"k", 1}} };
+    M_ASSERT_TRUE(unordered_find.find(find_key.substr(3, 1)) == nullptr);
+    M_ASSERT_TRUE(unordered_find.find("k") != nullptr);
+    unordered_find[find_key.substr(0, 4)] = 3;
+    M_ASSERT_EQ(unordered_find.at("key2").to<int>(), 3);
+    M_ASSERT_TRUE(unordered_find.erase(find_key.substr(0, 4)));
+    M_ASSERT_FALSE(unordered_find.contains("key2"));
+
+    // Old map types are still implicitly convertible
+    std::map<std::string, Json> std_map{{"x", 1}};
+    Json from_std_map = std_map;
+    M_ASSERT_EQ(from_std_map.find("x")->to<int>(), 1);
+
     // --- Type Safety ---
     M_ASSERT_THROW(std::ignore = obj_val.to<Json::Number>(), std::runtime_error);
     M_ASSERT_THROW(std::ignore = obj_val.arr(), std::bad_variant_access);
@@ -163,6 +163,24 @@ M_TEST(Value, String) {
         M_ASSERT_EQ(parsed_unicode_mixed->str(), "Hello 世界!");
     }
 
+    // Surrogate pair and upper-case hex digits
+    auto parsed_unicode_pair = Json::parse(R"("\uD83D\uDE00\u00E9")");
+    M_ASSERT_TRUE(parsed_unicode_pair.has_value());
+    M_ASSERT_EQ(parsed_unicode_pair->str(), "😀é");
+
+    // Escape at the very end of the text, and stream input
+    M_ASSERT_EQ(Json::parse(R"("\u4E2D")")->str(), "中");
+    std::istringstream unicode_stream{ R"("\ud83d\ude00\u4e2d")" };
+    M_ASSERT_EQ(Json::parse(unicode_stream)->str(), "😀中");
+
+    // Illegal unicode escapes
+    M_ASSERT_FALSE(Json::parse(R"("\u12G4")").has_value());
+    M_ASSERT_FALSE(Json::parse(R"("\uDE00")").has_value());
+    M_ASSERT_FALSE(Json::parse(R"("\uD83D")").has_value());
+    M_ASSERT_FALSE(Json::parse(R"("\uD83DA")").has_value());
+    M_ASSERT_FALSE(Json::parse(R"("\uD83D\uDE0")").has_value());
+    M_ASSERT_FALSE(Json::parse(R"("\u00")").has_value());
+
     // Unicode round-trip: parse then serialize
     auto unicode_roundtrip = Json::parse(R"("\u4e16\u754c")");
     if (unicode_roundtrip.has_value()) {
@@ -174,6 +192,20 @@ M_TEST(Value, String) {
     Json control_chars{"\x01\x02\x03\x1f"};
     auto control_serialized = control_chars.dump();
     M_ASSERT_TRUE(control_serialized.find("\\u") != std::string::npos);
+    M_ASSERT_EQ(control_serialized, R"("\u0001\u0002\u0003\u001f")");
+
+    // Long strings, escapes at block boundaries and non-ASCII bytes are kept as-is
+    const std::string long_raw = std::string(15, 'a') + "\"" + std::string(16, 'b') + "\n" + "中文" + std::string(7, 'c') + "\\";
+    const std::string long_escaped = "\"" + std::string(15, 'a') + "\\\"" + std::string(16, 'b') + "\\n" + "中文" + std::string(7, 'c') + "\\\\\"";
+    M_ASSERT_EQ(Json{long_raw}.dump(), long_escaped);
+    std::ostringstream long_stream;
+    Json{long_raw}.write(long_stream);
+    M_ASSERT_EQ(long_stream.str(), long_escaped);
+    M_ASSERT_EQ(Json::parse(long_escaped)->str(), long_raw);
+
+    // Raw tab is accepted, the clean run before an escape is kept
+    M_ASSERT_EQ(Json::parse("\"a\tb\"")->str(), "a\tb");
+    M_ASSERT_EQ(Json::parse(R"({"key_with_a_long_name":1,"k\"q":2})")->obj().begin()->first, "k\"q");
 
     // --- Type safety ---
     M_ASSERT_THROW(std::ignore = str_val.to<Json::Number>(), std::runtime_error);